@@ -0,0 +1,287 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "FakeTrajectory.hpp"
+
+#include <math.h>
+#include <stdio.h>
+
+#include <mathlib/mathlib.h>
+#include <parameters/param.h>
+#include <px4_platform_common/log.h>
+
+static constexpr double EARTH_RADIUS = 6371000.0;	///< [m]
+
+void FakeTrajectory::init(hrt_abstime start)
+{
+	int32_t mode = 0;
+	int32_t rate = 5;
+	float heading_deg = 0.0f;
+
+	param_t handle = param_find("GPS_FAKE_MODE");
+
+	if (handle != PARAM_INVALID) {
+		param_get(handle, &mode);
+	}
+
+	handle = param_find("GPS_FAKE_RATE");
+
+	if (handle != PARAM_INVALID) {
+		param_get(handle, &rate);
+	}
+
+	handle = param_find("GPS_FAKE_SPEED");
+
+	if (handle != PARAM_INVALID) {
+		param_get(handle, &_speed);
+	}
+
+	handle = param_find("GPS_FAKE_DIST");
+
+	if (handle != PARAM_INVALID) {
+		param_get(handle, &_distance);
+	}
+
+	handle = param_find("GPS_FAKE_HDG");
+
+	if (handle != PARAM_INVALID) {
+		param_get(handle, &heading_deg);
+	}
+
+	handle = param_find("GPS_FAKE_NOISE");
+
+	if (handle != PARAM_INVALID) {
+		param_get(handle, &_noise);
+	}
+
+	_mode = (Mode)math::constrain(mode, (int32_t)Mode::Static, (int32_t)Mode::Waypoints);
+	_interval = 1000000 / math::constrain(rate, (int32_t)1, (int32_t)50);
+	_distance = math::max(_distance, 1.0f);
+	_heading = math::radians(heading_deg);
+	_noise = math::max(_noise, 0.0f);
+
+	if (_mode == Mode::Waypoints && !loadWaypoints()) {
+		PX4_ERR("fake: no waypoints, using a fixed position");
+		_mode = Mode::Static;
+	}
+
+	_start = start;
+	_last_update = 0;
+}
+
+bool FakeTrajectory::loadWaypoints()
+{
+	FILE *file = fopen(PX4_STORAGEDIR "/gps_fake_wp.txt", "r");
+
+	if (file == nullptr) {
+		return false;
+	}
+
+	char line[80];
+	_num_waypoints = 0;
+
+	while (_num_waypoints < MAX_WAYPOINTS && fgets(line, sizeof(line), file)) {
+		double lat, lon;
+		float alt;
+
+		if (line[0] == '#' || sscanf(line, "%lf %lf %f", &lat, &lon, &alt) != 3) {
+			continue;
+		}
+
+		// the first waypoint is the reference
+		if (_num_waypoints == 0) {
+			_ref_lat = lat;
+			_ref_lon = lon;
+			_ref_alt = alt;
+		}
+
+		Waypoint &waypoint = _waypoints[_num_waypoints++];
+		waypoint.north = (float)((lat - _ref_lat) * M_PI / 180.0 * EARTH_RADIUS);
+		waypoint.east = (float)((lon - _ref_lon) * M_PI / 180.0 * EARTH_RADIUS * cos(_ref_lat * M_PI / 180.0));
+		waypoint.up = alt - _ref_alt;
+	}
+
+	fclose(file);
+
+	// closed loop, back to the first waypoint
+	_loop_length = 0.0f;
+
+	for (int i = 0; i < _num_waypoints; i++) {
+		const Waypoint &from = _waypoints[i];
+		const Waypoint &to = _waypoints[(i + 1) % _num_waypoints];
+		_loop_length += sqrtf((to.north - from.north) * (to.north - from.north) + (to.east - from.east) *
+				      (to.east - from.east) + (to.up - from.up) * (to.up - from.up));
+	}
+
+	return _num_waypoints >= 2 && _loop_length > 0.0f;
+}
+
+void FakeTrajectory::trajectory(double t, float pos[3], float vel[3]) const
+{
+	for (int i = 0; i < 3; i++) {
+		pos[i] = 0.0f;
+		vel[i] = 0.0f;
+	}
+
+	switch (_mode) {
+	case Mode::Static:
+		break;
+
+	case Mode::Circle: {
+			// counter-clockwise seen from above, around the reference
+			const float angle = (float)fmod((double)_speed / (double)_distance * t, 2.0 * M_PI);
+			pos[0] = _distance * cosf(angle);
+			pos[1] = _distance * sinf(angle);
+			vel[0] = -_speed * sinf(angle);
+			vel[1] = _speed * cosf(angle);
+		}
+		break;
+
+	case Mode::Line: {
+			// from the reference to the end of the line and back
+			const float s = (float)fmod((double)_speed * t, 2.0 * (double)_distance);
+			const float direction = s < _distance ? 1.0f : -1.0f;
+			const float d = s < _distance ? s : 2.0f * _distance - s;
+			pos[0] = d * cosf(_heading);
+			pos[1] = d * sinf(_heading);
+			vel[0] = direction * _speed * cosf(_heading);
+			vel[1] = direction * _speed * sinf(_heading);
+		}
+		break;
+
+	case Mode::Waypoints: {
+			float s = (float)fmod((double)_speed * t, (double)_loop_length);
+
+			for (int i = 0; i < _num_waypoints; i++) {
+				const Waypoint &from = _waypoints[i];
+				const Waypoint &to = _waypoints[(i + 1) % _num_waypoints];
+				const float delta[3] {to.north - from.north, to.east - from.east, to.up - from.up};
+				const float length = sqrtf(delta[0] * delta[0] + delta[1] * delta[1] + delta[2] * delta[2]);
+
+				if (s <= length || i == _num_waypoints - 1) {
+					const float fraction = length > 0.0f ? math::min(s / length, 1.0f) : 0.0f;
+					const float from_pos[3] {from.north, from.east, from.up};
+
+					for (int axis = 0; axis < 3; axis++) {
+						pos[axis] = from_pos[axis] + fraction * delta[axis];
+						vel[axis] = length > 0.0f ? delta[axis] / length * _speed : 0.0f;
+					}
+
+					break;
+				}
+
+				s -= length;
+			}
+		}
+		break;
+	}
+}
+
+float FakeTrajectory::gaussian()
+{
+	// xorshift32 and Box-Muller: reproducible and without libc state
+	float u[2];
+
+	for (int i = 0; i < 2; i++) {
+		_random_state ^= _random_state << 13;
+		_random_state ^= _random_state >> 17;
+		_random_state ^= _random_state << 5;
+		u[i] = ((_random_state >> 8) + 1) / 16777217.0f;	// (0, 1]
+	}
+
+	return sqrtf(-2.0f * logf(u[0])) * cosf(2.0f * M_PI_F * u[1]);
+}
+
+void FakeTrajectory::update(hrt_abstime t, vehicle_gps_position_s &report)
+{
+	float pos[3];
+	float vel[3];
+	trajectory((t - _start) * 1e-6, pos, vel);
+
+	if (_noise > 0.0f) {
+		// first order Gauss-Markov position noise, like the slowly wandering error of a real receiver,
+		// and white velocity noise
+		const float dt = _last_update != 0 ? (t - _last_update) * 1e-6f : NOISE_TIME_CONSTANT;
+		const float a = expf(-dt / NOISE_TIME_CONSTANT);
+		const float b = sqrtf(1.0f - a * a);
+
+		for (int axis = 0; axis < 3; axis++) {
+			const float sigma = axis == 2 ? 1.5f * _noise : _noise;
+			_pos_noise[axis] = a * _pos_noise[axis] + b * sigma * gaussian();
+			pos[axis] += _pos_noise[axis];
+			vel[axis] += 0.1f * sigma * gaussian();
+		}
+	}
+
+	_last_update = t;
+
+	const double lat = _ref_lat + (double)pos[0] / EARTH_RADIUS * 180.0 / M_PI;
+	const double lon = _ref_lon + (double)pos[1] / (EARTH_RADIUS * cos(_ref_lat * M_PI / 180.0)) * 180.0 / M_PI;
+
+	report.timestamp = t;
+	report.lat = (int32_t)(lat * 1e7);
+	report.lon = (int32_t)(lon * 1e7);
+	report.alt = (int32_t)((_ref_alt + pos[2]) * 1e3f);
+	report.alt_ellipsoid = report.alt + 47000;	// approximate geoid height at the default reference
+	report.s_variance_m_s = 0.5f + 0.1f * _noise;
+	report.c_variance_rad = 0.1f;
+	report.fix_type = 3;
+	report.eph = 0.8f + _noise;
+	report.epv = 1.2f + 1.5f * _noise;
+	report.hdop = 0.9f;
+	report.vdop = 0.9f;
+	report.vel_n_m_s = vel[0];
+	report.vel_e_m_s = vel[1];
+	report.vel_d_m_s = -vel[2];
+	report.vel_m_s = sqrtf(vel[0] * vel[0] + vel[1] * vel[1]);
+	report.cog_rad = atan2f(vel[1], vel[0]);
+	report.vel_ned_valid = true;
+	report.satellites_used = 10;
+	report.heading = NAN;
+	report.heading_offset = NAN;
+
+	/* no time and satellite information simulated */
+}
+
+void FakeTrajectory::print_status() const
+{
+	static const char *const mode_names[] {"fixed position", "circle", "line", "waypoints"};
+
+	PX4_INFO("fake trajectory: %s, %.1f Hz, speed %.1f m/s, noise %.1f m", mode_names[(int)_mode],
+		 (double)(1e6f / _interval), (double)_speed, (double)_noise);
+
+	if (_mode == Mode::Waypoints) {
+		PX4_INFO("%i waypoints, loop length %.1f m", _num_waypoints, (double)_loop_length);
+	}
+}
@@ -0,0 +1,122 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file FakeTrajectory.hpp
+ *
+ * Trajectory generator for the fake GPS mode
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <uORB/topics/vehicle_gps_position.h>
+
+/**
+ * Generates the reports of the fake GPS mode: a fixed position, a circle, a back and forth line or a loop over
+ * the waypoints of a file, with optional noise. The reports are computed for their scheduled time, so that the
+ * trajectory does not depend on the scheduling jitter.
+ */
+class FakeTrajectory
+{
+public:
+	enum class Mode : int32_t {
+		Static = 0,
+		Circle,
+		Line,
+		Waypoints
+	};
+
+	FakeTrajectory() = default;
+	~FakeTrajectory() = default;
+
+	/**
+	 * Load the parameters (GPS_FAKE_*) and the waypoint file
+	 * @param start time of the first report
+	 */
+	void init(hrt_abstime start);
+
+	/**
+	 * Fill in the report for a time
+	 */
+	void update(hrt_abstime t, vehicle_gps_position_s &report);
+
+	/** @return interval between 2 reports [us] */
+	uint32_t interval() const { return _interval; }
+
+	void print_status() const;
+
+private:
+	static constexpr int MAX_WAYPOINTS = 32;
+	static constexpr float NOISE_TIME_CONSTANT = 10.0f;	///< [s] correlation time of the position noise
+
+	/** waypoint, in meters north/east/up of the reference */
+	struct Waypoint {
+		float north;
+		float east;
+		float up;
+	};
+
+	/** load PX4_STORAGEDIR/gps_fake_wp.txt: one "lat lon alt" line per waypoint [deg, deg, m AMSL] */
+	bool loadWaypoints();
+
+	/**
+	 * Position [m] and velocity [m/s], north/east/up of the reference, at time t [s] since the start.
+	 * t is a double: in float, the distance along the trajectory loses its centimeters after a few hours.
+	 */
+	void trajectory(double t, float pos[3], float vel[3]) const;
+
+	/** @return a normally distributed random number */
+	float gaussian();
+
+	Mode _mode{Mode::Static};
+	uint32_t _interval{200000};	///< [us]
+	float _speed{5.0f};		///< [m/s]
+	float _distance{50.0f};		///< circle radius or line length [m]
+	float _heading{0.0f};		///< line direction [rad]
+	float _noise{0.0f};		///< position noise standard deviation [m]
+
+	double _ref_lat{47.378301};	///< [deg]
+	double _ref_lon{8.538777};	///< [deg]
+	float _ref_alt{1200.0f};	///< [m AMSL]
+
+	Waypoint _waypoints[MAX_WAYPOINTS] {};
+	int _num_waypoints{0};
+	float _loop_length{0.0f};	///< length of the waypoint loop [m]
+
+	hrt_abstime _start{0};
+	hrt_abstime _last_update{0};
+	float _pos_noise[3] {};		///< correlated position noise, north/east/up [m]
+	uint32_t _random_state{0x12345678};
+};
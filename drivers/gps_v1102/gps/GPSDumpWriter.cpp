@@ -0,0 +1,318 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file GPSDumpWriter.cpp
+ */
+
+#include "GPSDumpWriter.hpp"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <mathlib/mathlib.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/time.h>
+
+GPSDumpWriter::GPSDumpWriter(Mode mode, int instance) :
+	ScheduledWorkItem(MODULE_NAME"_dump", gps::storage_wq),
+	_mode(mode),
+	_instance(instance)
+{
+	static_assert((BUFFER_SIZE & (BUFFER_SIZE - 1)) == 0, "BUFFER_SIZE must be a power of 2");
+}
+
+GPSDumpWriter::~GPSDumpWriter()
+{
+	ScheduleClear();
+
+	// wait for a running cycle to finish, the buffer is not used by Run() afterwards
+	int expected = (int)RunState::Idle;
+
+	while (!_run_state.compare_exchange(&expected, (int)RunState::Exit)) {
+		expected = (int)RunState::Idle;
+		px4_usleep(1000);
+	}
+
+	// write what is left
+	if (_fd >= 0) {
+		writeFile(_head.load(), _tail.load(), true);
+		::close(_fd);
+
+	} else if (_buffer != nullptr) {
+		publishRecords(_head.load(), _tail.load(), UINT_MAX);
+		flushChunk(false);
+		flushChunk(true);
+	}
+
+	delete[] _buffer;
+
+	perf_free(_overruns);
+	perf_free(_write_errors);
+	perf_free(_write_perf);
+}
+
+bool GPSDumpWriter::init()
+{
+	_buffer = new uint8_t[BUFFER_SIZE];
+
+	if (_buffer == nullptr) {
+		PX4_ERR("failed to allocate dump buffer");
+		return false;
+	}
+
+	if (_mode == Mode::File) {
+		char path[64];
+		snprintf(path, sizeof(path), PX4_STORAGEDIR "/gps%i_dump.bin", _instance + 1);
+		_fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+		if (_fd < 0) {
+			PX4_ERR("failed to open %s", path);
+			return false;
+		}
+
+	} else {
+		//make sure to use a large enough queue size, so that we don't lose messages. You may also want
+		//to increase the logger rate for that.
+		_dump_pub.advertise();
+	}
+
+	ScheduleOnInterval(_mode == Mode::File ? WRITE_INTERVAL : PUBLISH_INTERVAL);
+
+	return true;
+}
+
+void GPSDumpWriter::copyIn(uint32_t pos, const void *src, size_t len)
+{
+	const uint32_t index = pos & (BUFFER_SIZE - 1);
+	const size_t first = math::min((size_t)(BUFFER_SIZE - index), len);
+
+	memcpy(&_buffer[index], src, first);
+	memcpy(&_buffer[0], (const uint8_t *)src + first, len - first);
+}
+
+void GPSDumpWriter::copyOut(uint32_t pos, void *dst, size_t len) const
+{
+	const uint32_t index = pos & (BUFFER_SIZE - 1);
+	const size_t first = math::min((size_t)(BUFFER_SIZE - index), len);
+
+	memcpy(dst, &_buffer[index], first);
+	memcpy((uint8_t *)dst + first, &_buffer[0], len - first);
+}
+
+void GPSDumpWriter::append(const uint8_t *data, size_t len, bool to_device)
+{
+	if (_buffer == nullptr || len == 0) {
+		return;
+	}
+
+	const uint32_t head = _head.load();
+	const uint32_t tail = _tail.load();
+	const uint32_t record_size = sizeof(RecordHeader) + len;
+	const uint32_t seq = _seq++;
+
+	// the indices are free running, their difference is the number of used bytes
+	if (len > UINT16_MAX || record_size > BUFFER_SIZE - (head - tail)) {
+		perf_count(_overruns);
+		_dropped_bytes += len;
+		return;
+	}
+
+	RecordHeader header;
+	header.timestamp = hrt_absolute_time();
+	header.seq = seq;
+	header.len = len;
+	header.flags = to_device ? RECORD_FLAG_TO_DEVICE : 0;
+
+	copyIn(head, &header, sizeof(header));
+	copyIn(head + sizeof(header), data, len);
+
+	// publish the record to the consumer
+	_head.store(head + record_size);
+}
+
+void GPSDumpWriter::Run()
+{
+	int expected = (int)RunState::Idle;
+
+	if (!_run_state.compare_exchange(&expected, (int)RunState::Running)) {
+		return;
+	}
+
+	const uint32_t head = _head.load();
+	const uint32_t tail = _tail.load();
+
+	perf_begin(_write_perf);
+
+	if (_mode == Mode::File) {
+		writeFile(head, tail, false);
+
+	} else {
+		// the logger reads the queue at its own rate: don't publish more than fits into the queue at once,
+		// the rest is published in the next cycle
+		_chunks_published = 0;
+		publishRecords(head, tail, gps_dump_s::ORB_QUEUE_LENGTH);
+
+		// do not hold back the end of a message at low data rates
+		if (_dump_from_device.len > 0 && hrt_elapsed_time(&_dump_from_device.timestamp) > CHUNK_FLUSH_TIMEOUT
+		    && _chunks_published < gps_dump_s::ORB_QUEUE_LENGTH) {
+			flushChunk(false);
+		}
+
+		if (_dump_to_device.len > 0 && hrt_elapsed_time(&_dump_to_device.timestamp) > CHUNK_FLUSH_TIMEOUT
+		    && _chunks_published < gps_dump_s::ORB_QUEUE_LENGTH) {
+			flushChunk(true);
+		}
+	}
+
+	perf_end(_write_perf);
+
+	_run_state.store((int)RunState::Idle);
+}
+
+void GPSDumpWriter::writeFile(uint32_t head, uint32_t tail, bool force)
+{
+	const uint32_t used = head - tail;
+
+	if (used == 0) {
+		return;
+	}
+
+	// collect large blocks, unless data would stay in the buffer for too long
+	if (!force && used < FILE_BLOCK_SIZE && hrt_elapsed_time(&_last_file_write) < FILE_FLUSH_INTERVAL) {
+		return;
+	}
+
+	// the records are written as they are in the buffer, in one or two contiguous parts
+	const uint32_t index = tail & (BUFFER_SIZE - 1);
+	const uint32_t first = math::min(BUFFER_SIZE - index, used);
+
+	if (::write(_fd, &_buffer[index], first) != (ssize_t)first) {
+		perf_count(_write_errors);
+	}
+
+	if (used > first && ::write(_fd, &_buffer[0], used - first) != (ssize_t)(used - first)) {
+		perf_count(_write_errors);
+	}
+
+	_last_file_write = hrt_absolute_time();
+	_tail.store(head);
+}
+
+void GPSDumpWriter::publishRecords(uint32_t head, uint32_t tail, unsigned max_chunks)
+{
+	while (tail != head) {
+		if (_record_left == 0) {
+			RecordHeader header;
+			copyOut(tail, &header, sizeof(header));
+
+			// a chunk never spans data of the other direction, so ordering the chunks by timestamp gives the
+			// order in which the data was exchanged
+			const bool to_device = header.flags & RECORD_FLAG_TO_DEVICE;
+			const gps_dump_s &other_dump = to_device ? _dump_from_device : _dump_to_device;
+
+			if (other_dump.len > 0) {
+				if (_chunks_published >= max_chunks) {
+					break;
+				}
+
+				flushChunk(!to_device);
+			}
+
+			_record = header;
+			_record_left = header.len;
+			tail += sizeof(header);
+			_tail.store(tail);
+		}
+
+		const bool to_device = _record.flags & RECORD_FLAG_TO_DEVICE;
+		gps_dump_s &dump = to_device ? _dump_to_device : _dump_from_device;
+		const size_t write_len = math::min((size_t)_record_left, sizeof(dump.data) - dump.len);
+
+		// a record that does not fit into the remaining messages of this cycle is continued in the next one
+		if (dump.len + write_len >= sizeof(dump.data) && _chunks_published >= max_chunks) {
+			break;
+		}
+
+		if (dump.len == 0) {
+			dump.timestamp = _record.timestamp;
+		}
+
+		copyOut(tail, dump.data + dump.len, write_len);
+		tail += write_len;
+		dump.len += write_len;
+		_record_left -= write_len;
+
+		if (dump.len >= sizeof(dump.data)) {
+			flushChunk(to_device);
+		}
+
+		// free the published data
+		_tail.store(tail);
+	}
+}
+
+void GPSDumpWriter::flushChunk(bool to_device)
+{
+	gps_dump_s &dump = to_device ? _dump_to_device : _dump_from_device;
+
+	if (dump.len == 0) {
+		return;
+	}
+
+	// the remaining bytes of a record split over several chunks have the same timestamp
+	if (dump.timestamp <= _last_chunk_timestamp) {
+		dump.timestamp = _last_chunk_timestamp + 1;
+	}
+
+	_last_chunk_timestamp = dump.timestamp;
+
+	if (to_device) {
+		dump.len |= 1 << 7;
+	}
+
+	_dump_pub.publish(dump);
+	dump.len = 0;
+	++_chunks_published;
+}
+
+void GPSDumpWriter::print_status()
+{
+	PX4_INFO("dump: %s, buffer %u/%u bytes used, %u bytes dropped", _mode == Mode::File ? "file" : "log",
+		 (unsigned)(_head.load() - _tail.load()), (unsigned)BUFFER_SIZE, (unsigned)_dropped_bytes);
+	perf_print_counter(_overruns);
+	perf_print_counter(_write_errors);
+	perf_print_counter(_write_perf);
+}
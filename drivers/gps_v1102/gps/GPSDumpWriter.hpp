@@ -0,0 +1,165 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file GPSDumpWriter.hpp
+ *
+ * Dump of the GPS communication, decoupled from the gps thread
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <lib/perf/perf_counter.h>
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <uORB/PublicationQueued.hpp>
+#include <uORB/topics/gps_dump.h>
+
+#include "GPSStorageQueue.hpp"
+
+/**
+ * The gps thread appends the data to a single-producer/single-consumer ring buffer, which is drained in
+ * large blocks from a low priority work queue. This way, dumping cannot delay the position publication:
+ * if the writer falls behind, data is dropped and counted instead.
+ * In log mode, at most the gps_dump queue length is published per cycle, so that the logger does not miss
+ * chunks. This limits the log mode to about 60 kB/s, higher rates need the file mode.
+ */
+class GPSDumpWriter : public px4::ScheduledWorkItem
+{
+public:
+	enum class Mode : int32_t {
+		Disabled = 0,
+		Log,		///< publish gps_dump for the logger
+		File		///< write to PX4_STORAGEDIR/gps<instance>_dump.bin
+	};
+
+	GPSDumpWriter(Mode mode, int instance);
+	~GPSDumpWriter() override;
+
+	/**
+	 * Allocate the buffer, open the file and start the writer
+	 * @return true on success
+	 */
+	bool init();
+
+	/**
+	 * Append data to the dump. Only call from one thread, the gps thread. Does not block.
+	 * @param to_device true for data sent to the device, false for received data
+	 */
+	void append(const uint8_t *data, size_t len, bool to_device);
+
+	void print_status();
+
+private:
+	/**
+	 * Header in front of the data of each append() call, in the ring buffer and the dump file:
+	 * timestamp of the first byte [us], sequence number, data length, flags (bit 0 set: data was sent to the
+	 * device), all little endian. The sequence number is shared by both directions and also counts the dropped
+	 * records, so a gap in the file shows an overrun.
+	 */
+	struct __attribute__((packed)) RecordHeader {
+		uint64_t timestamp;
+		uint32_t seq;
+		uint16_t len;
+		uint8_t flags;
+	};
+
+	static constexpr uint8_t RECORD_FLAG_TO_DEVICE = 1 << 0;
+
+	static constexpr uint32_t BUFFER_SIZE = 16384;			///< [bytes], must be a power of 2
+	static constexpr uint32_t FILE_BLOCK_SIZE = 4096;		///< data is written to the file in blocks of this size
+	static constexpr uint32_t FILE_FLUSH_INTERVAL = 1000000;	///< [us] max time to wait for a full block
+	static constexpr uint32_t WRITE_INTERVAL = 50000;		///< [us] file mode
+	static constexpr uint32_t PUBLISH_INTERVAL = 10000;		///< [us] log mode
+	static constexpr uint32_t CHUNK_FLUSH_TIMEOUT = 100000;	///< [us] max time a partial gps_dump chunk is held back
+
+	void Run() override;
+
+	/** copy from the ring buffer, at position pos (not wrapped) */
+	void copyOut(uint32_t pos, void *dst, size_t len) const;
+
+	/** copy into the ring buffer, at position pos (not wrapped) */
+	void copyIn(uint32_t pos, const void *src, size_t len);
+
+	/**
+	 * write the ring buffer contents to the file, if there is enough of it
+	 * @param force write whatever is buffered
+	 */
+	void writeFile(uint32_t head, uint32_t tail, bool force);
+
+	/**
+	 * split the records into gps_dump messages and publish them
+	 * @param max_chunks stop before a message that would exceed this number of published messages, a record that
+	 * does not fit is continued in the next call
+	 */
+	void publishRecords(uint32_t head, uint32_t tail, unsigned max_chunks);
+
+	/** publish the partial gps_dump chunk of a direction, if any */
+	void flushChunk(bool to_device);
+
+	enum class RunState : int {
+		Idle = 0,
+		Running,	///< Run() is using the buffer
+		Exit		///< the destructor owns the buffer, Run() returns right away
+	};
+
+	const Mode _mode;
+	const int _instance;
+
+	px4::atomic<int> _run_state{(int)RunState::Idle};
+
+	uint8_t *_buffer{nullptr};
+	px4::atomic<uint32_t> _head{0};	///< written by the producer only
+	px4::atomic<uint32_t> _tail{0};	///< written by the consumer only
+
+	// Log mode
+	uORB::PublicationQueued<gps_dump_s> _dump_pub{ORB_ID(gps_dump)};
+	gps_dump_s _dump_from_device{};		///< timestamp is the time of the first byte
+	gps_dump_s _dump_to_device{};
+	hrt_abstime _last_chunk_timestamp{0};	///< the chunk timestamps are strictly increasing
+	unsigned _chunks_published{0};		///< in the current cycle
+	RecordHeader _record{};			///< record being published
+	uint16_t _record_left{0};		///< bytes of _record that are not published yet
+
+	// File mode
+	int _fd{-1};
+	hrt_abstime _last_file_write{0};
+
+	uint32_t _seq{0};		///< next record sequence number
+	uint32_t _dropped_bytes{0};
+
+	perf_counter_t _overruns{perf_alloc(PC_COUNT, MODULE_NAME": dump overrun")};
+	perf_counter_t _write_errors{perf_alloc(PC_COUNT, MODULE_NAME": dump write error")};
+	perf_counter_t _write_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": dump write")};
+};
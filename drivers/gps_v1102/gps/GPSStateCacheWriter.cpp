@@ -0,0 +1,250 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file GPSStateCacheWriter.cpp
+ */
+
+#include "GPSStateCacheWriter.hpp"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <mathlib/mathlib.h>
+#include <px4_platform_common/log.h>
+
+GPSStateCacheWriter::GPSStateCacheWriter(int instance) :
+	ScheduledWorkItem(MODULE_NAME"_state_cache", gps::storage_wq),
+	_instance(instance)
+{
+	static_assert((BUFFER_SIZE & (BUFFER_SIZE - 1)) == 0, "BUFFER_SIZE must be a power of 2");
+}
+
+GPSStateCacheWriter::~GPSStateCacheWriter()
+{
+	ScheduleClear();
+
+	// an unfinished dump is incomplete, keep the previous file
+	if (_nav_db_fd >= 0) {
+		closeNavDatabase(false);
+	}
+
+	delete[] _buffer;
+
+	perf_free(_write_errors);
+	perf_free(_write_perf);
+}
+
+bool GPSStateCacheWriter::init()
+{
+	_buffer = new uint8_t[BUFFER_SIZE];
+
+	if (_buffer == nullptr) {
+		PX4_ERR("failed to allocate state cache buffer");
+		return false;
+	}
+
+	ScheduleOnInterval(WRITE_INTERVAL);
+
+	return true;
+}
+
+void GPSStateCacheWriter::filePath(char *path, size_t path_length, int instance, const char *type, bool tmp)
+{
+	snprintf(path, path_length, PX4_STORAGEDIR "/gps%i_%s.bin%s", instance + 1, type, tmp ? ".tmp" : "");
+}
+
+void GPSStateCacheWriter::saveState(const GPSReceiverState &state)
+{
+	// skip it if the writer did not get to the previous one yet, the state is saved periodically anyway
+	if (!_state_pending.load()) {
+		_state = state;
+		_state_pending.store(true);
+	}
+}
+
+void GPSStateCacheWriter::appendNavDatabase(const uint8_t *data, uint16_t len)
+{
+	if (_buffer == nullptr || len == 0) {
+		return;
+	}
+
+	const uint32_t head = _head.load();
+	const uint32_t tail = _tail.load();
+	const uint32_t record_size = sizeof(len) + len;
+
+	// the indices are free running, their difference is the number of used bytes
+	if (record_size > BUFFER_SIZE - (head - tail)) {
+		_nav_db_overflow.store(true);
+		return;
+	}
+
+	// store as [length][data] records (the file format), so that the chunks can be sent back one by one
+	copyIn(head, &len, sizeof(len));
+	copyIn(head + sizeof(len), data, len);
+
+	// publish the record to the consumer
+	_head.store(head + record_size);
+}
+
+void GPSStateCacheWriter::copyIn(uint32_t pos, const void *src, size_t len)
+{
+	const uint32_t index = pos & (BUFFER_SIZE - 1);
+	const size_t first = math::min((size_t)(BUFFER_SIZE - index), len);
+
+	memcpy(&_buffer[index], src, first);
+	memcpy(&_buffer[0], (const uint8_t *)src + first, len - first);
+}
+
+void GPSStateCacheWriter::finishNavDatabase()
+{
+	_nav_db_complete.store(true);
+}
+
+bool GPSStateCacheWriter::writeChecked(int fd, const void *data, size_t len)
+{
+	if (::write(fd, data, len) != (ssize_t)len) {
+		perf_count(_write_errors);
+		return false;
+	}
+
+	return true;
+}
+
+void GPSStateCacheWriter::Run()
+{
+	perf_begin(_write_perf);
+
+	if (_state_pending.load()) {
+		char path[64];
+		filePath(path, sizeof(path), _instance, "state", false);
+		int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+		if (fd >= 0) {
+			writeChecked(fd, &_state, sizeof(_state));
+			::close(fd);
+
+		} else {
+			perf_count(_write_errors);
+		}
+
+		_state_pending.store(false);
+	}
+
+	// read the flag before the data: everything appended before the dump was finished is in the file
+	const bool nav_db_complete = _nav_db_complete.load();
+
+	writeNavDatabase(_head.load(), _tail.load());
+
+	if (nav_db_complete) {
+		_nav_db_complete.store(false);
+		closeNavDatabase(!_nav_db_overflow.load());
+		_nav_db_overflow.store(false);
+	}
+
+	perf_end(_write_perf);
+}
+
+void GPSStateCacheWriter::writeNavDatabase(uint32_t head, uint32_t tail)
+{
+	const uint32_t used = head - tail;
+
+	if (used == 0) {
+		return;
+	}
+
+	if (_nav_db_fd < 0) {
+		char path[64];
+		filePath(path, sizeof(path), _instance, "navdb", true);
+		_nav_db_fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+		_nav_db_failed = _nav_db_fd < 0;
+		_nav_db_written = 0;
+
+		if (_nav_db_failed) {
+			perf_count(_write_errors);
+		}
+	}
+
+	if (_nav_db_fd >= 0 && !_nav_db_failed) {
+		// the records are written as they are in the buffer, in one or two contiguous parts
+		const uint32_t index = tail & (BUFFER_SIZE - 1);
+		const uint32_t first = math::min(BUFFER_SIZE - index, used);
+
+		_nav_db_failed = !writeChecked(_nav_db_fd, &_buffer[index], first)
+				 || (used > first && !writeChecked(_nav_db_fd, &_buffer[0], used - first));
+		_nav_db_written += used;
+	}
+
+	// free the records, also if they could not be written
+	_tail.store(head);
+}
+
+void GPSStateCacheWriter::closeNavDatabase(bool complete)
+{
+	if (_nav_db_fd < 0) {
+		return;
+	}
+
+	const bool synced = ::fsync(_nav_db_fd) == 0;
+	const bool closed = ::close(_nav_db_fd) == 0;
+	_nav_db_fd = -1;
+
+	char path_tmp[64];
+	filePath(path_tmp, sizeof(path_tmp), _instance, "navdb", true);
+
+	if (complete && synced && closed && !_nav_db_failed) {
+		char path[64];
+		filePath(path, sizeof(path), _instance, "navdb", false);
+
+		if (rename(path_tmp, path) == 0) {
+			_nav_db_size = _nav_db_written;
+			return;
+		}
+
+		perf_count(_write_errors);
+	}
+
+	unlink(path_tmp);
+	++_nav_db_discarded;
+}
+
+void GPSStateCacheWriter::print_status()
+{
+	PX4_INFO("state cache: navigation database %u bytes, %u incomplete dumps discarded", (unsigned)_nav_db_size,
+		 _nav_db_discarded);
+	perf_print_counter(_write_errors);
+	perf_print_counter(_write_perf);
+}
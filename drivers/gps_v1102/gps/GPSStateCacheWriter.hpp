@@ -0,0 +1,129 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file GPSStateCacheWriter.hpp
+ *
+ * Writes the receiver state cache, decoupled from the gps thread
+ */
+
+#pragma once
+
+#include <lib/perf/perf_counter.h>
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+
+#include "devices/src/gps_helper.h"
+#include "GPSStorageQueue.hpp"
+
+/**
+ * The gps thread hands over the receiver state and the navigation database chunks without blocking, and the
+ * files are written from a low priority work queue. SD card stalls therefore cannot delay the position
+ * publication. A database dump that does not fit into the buffer is discarded, keeping the previous file.
+ *
+ * Files (per instance, in PX4_STORAGEDIR): gps<instance>_state.bin with a GPSReceiverState and
+ * gps<instance>_navdb.bin with [uint16 length][data] records, one per database chunk.
+ */
+class GPSStateCacheWriter : public px4::ScheduledWorkItem
+{
+public:
+	GPSStateCacheWriter(int instance);
+	~GPSStateCacheWriter() override;
+
+	/**
+	 * Allocate the buffer and start the writer
+	 * @return true on success
+	 */
+	bool init();
+
+	/**
+	 * Get the path of a cache file
+	 * @param type "state" or "navdb"
+	 * @param tmp if true, get the path of the file while it is being written
+	 */
+	static void filePath(char *path, size_t path_length, int instance, const char *type, bool tmp);
+
+	/**
+	 * The following methods are only called from the gps thread and do not block.
+	 */
+
+	/** store the receiver state */
+	void saveState(const GPSReceiverState &state);
+
+	/** append a chunk of the navigation database dump */
+	void appendNavDatabase(const uint8_t *data, uint16_t len);
+
+	/** the navigation database dump is complete: replace the previous file */
+	void finishNavDatabase();
+
+	void print_status();
+
+private:
+	static constexpr uint32_t BUFFER_SIZE = 8192;		///< [bytes], must be a power of 2
+	static constexpr uint32_t WRITE_INTERVAL = 100000;	///< [us]
+
+	void Run() override;
+
+	/** copy into the ring buffer, at position pos (not wrapped) */
+	void copyIn(uint32_t pos, const void *src, size_t len);
+
+	/** write the buffered navigation database records to the temporary file */
+	void writeNavDatabase(uint32_t head, uint32_t tail);
+
+	/** close the temporary navigation database file, and replace the previous one if it is complete */
+	void closeNavDatabase(bool complete);
+
+	/** write a buffer to a file, counting errors */
+	bool writeChecked(int fd, const void *data, size_t len);
+
+	const int _instance;
+
+	uint8_t *_buffer{nullptr};
+	px4::atomic<uint32_t> _head{0};	///< written by the producer only
+	px4::atomic<uint32_t> _tail{0};	///< written by the consumer only
+
+	GPSReceiverState _state{};
+	px4::atomic<bool> _state_pending{false};	///< _state is owned by the writer while set
+	px4::atomic<bool> _nav_db_complete{false};
+	px4::atomic<bool> _nav_db_overflow{false};	///< a chunk of the current dump was dropped
+
+	int _nav_db_fd{-1};
+	bool _nav_db_failed{false};	///< a write of the current dump failed
+	uint32_t _nav_db_written{0};	///< [bytes] of the current dump
+	uint32_t _nav_db_size{0};	///< [bytes] of the last complete dump
+	unsigned _nav_db_discarded{0};	///< number of incomplete dumps
+
+	perf_counter_t _write_errors{perf_alloc(PC_COUNT, MODULE_NAME": state cache write error")};
+	perf_counter_t _write_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": state cache write")};
+};
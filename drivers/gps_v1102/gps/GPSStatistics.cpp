@@ -0,0 +1,151 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "GPSStatistics.hpp"
+
+#include <stdio.h>
+
+#include <px4_platform_common/log.h>
+
+const uint32_t GPSStatistics::latency_limits[9] {100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000};
+const uint32_t GPSStatistics::read_size_limits[7] {2, 4, 8, 16, 32, 64, 128};
+
+template<unsigned N>
+void Histogram<N>::print(const char *name, const char *unit) const
+{
+	PX4_INFO("%s [%s]: count %u, avg %u, max %u", name, unit, (unsigned)_count,
+		 _count > 0 ? (unsigned)(_sum / _count) : 0u, (unsigned)_max);
+
+	char line[160];
+	int len = 0;
+
+	for (unsigned i = 0; i <= N && len < (int)sizeof(line); i++) {
+		if (i < N) {
+			len += snprintf(line + len, sizeof(line) - len, " <%u: %u", (unsigned)_limits[i], (unsigned)_buckets[i]);
+
+		} else {
+			len += snprintf(line + len, sizeof(line) - len, " >=%u: %u", (unsigned)_limits[N - 1], (unsigned)_buckets[N]);
+		}
+	}
+
+	PX4_INFO(" %s", line);
+}
+
+GPSStatistics::~GPSStatistics()
+{
+	for (unsigned i = 0; i < _num_message_types; i++) {
+		perf_free(_message_types[i].parse_perf);
+	}
+}
+
+perf_counter_t GPSStatistics::parsePerf(uint32_t msg_id)
+{
+	for (unsigned i = 0; i < _num_message_types; i++) {
+		if (_message_types[i].msg_id == msg_id) {
+			return _message_types[i].parse_perf;
+		}
+	}
+
+	if (_num_message_types >= MAX_MESSAGE_TYPES) {
+		return nullptr;
+	}
+
+	MessageType &type = _message_types[_num_message_types];
+	type.msg_id = msg_id;
+
+	const char c0 = (msg_id >> 16) & 0xFF;
+	const char c1 = (msg_id >> 8) & 0xFF;
+	const char c2 = msg_id & 0xFF;
+
+	// NMEA sentence types are 3 letters, the other protocols have binary ids
+	if (c0 >= 'A' && c0 <= 'Z' && c1 >= 'A' && c1 <= 'Z' && c2 >= 'A' && c2 <= 'Z') {
+		snprintf(type.name, sizeof(type.name), MODULE_NAME": parse %c%c%c", c0, c1, c2);
+
+	} else {
+		snprintf(type.name, sizeof(type.name), MODULE_NAME": parse 0x%04x", (unsigned)msg_id);
+	}
+
+	type.parse_perf = perf_alloc(PC_ELAPSED, type.name);
+
+	if (type.parse_perf == nullptr) {
+		return nullptr;
+	}
+
+	_num_message_types++;
+
+	return type.parse_perf;
+}
+
+void GPSStatistics::messageReceived(const GPSMessageTiming &timing)
+{
+	if (timing.first_byte_time != 0 && timing.complete_time >= timing.first_byte_time) {
+		_transport.add(timing.complete_time - timing.first_byte_time);
+	}
+
+	perf_counter_t parse_perf = parsePerf(timing.msg_id);
+
+	if (parse_perf) {
+		perf_set_elapsed(parse_perf, timing.parse_duration);
+	}
+
+	if (timing.handled & 1) {
+		_epoch_complete_time = timing.complete_time + timing.parse_duration;
+	}
+}
+
+void GPSStatistics::published()
+{
+	if (_epoch_complete_time != 0) {
+		_publish_delay.add(hrt_elapsed_time(&_epoch_complete_time));
+		_epoch_complete_time = 0;
+	}
+}
+
+void GPSStatistics::updateRates(float dt)
+{
+	_poll_rate = _poll_wakeups / dt;
+	_poll_wakeups = 0;
+}
+
+void GPSStatistics::print_status()
+{
+	PX4_INFO("poll wake-ups: \t\t%6.2f Hz", (double)_poll_rate);
+	_read_size.print("read size", "bytes");
+	_transport.print("first byte to checksum", "us");
+	_publish_delay.print("epoch complete to publish", "us");
+
+	for (unsigned i = 0; i < _num_message_types; i++) {
+		perf_print_counter(_message_types[i].parse_perf);
+	}
+}
@@ -0,0 +1,135 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file GPSStatistics.hpp
+ *
+ * Latency and load statistics of the GPS receive path, from the serial port to the uORB publication
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <lib/perf/perf_counter.h>
+
+#include "devices/src/gps_helper.h"
+
+/**
+ * Histogram with fixed bucket limits
+ * @tparam N number of limits, there is one more bucket for the values above the last limit
+ */
+template<unsigned N>
+class Histogram
+{
+public:
+	explicit Histogram(const uint32_t (&limits)[N]) : _limits(limits) {}
+
+	void add(uint32_t value)
+	{
+		unsigned i = 0;
+
+		while (i < N && value >= _limits[i]) {
+			i++;
+		}
+
+		_buckets[i]++;
+		_count++;
+		_sum += value;
+
+		if (value > _max) {
+			_max = value;
+		}
+	}
+
+	/** print the summary and the buckets, e.g. "<500: 3 <1000: 12 ... >=50000: 0" */
+	void print(const char *name, const char *unit) const;
+
+private:
+	const uint32_t (&_limits)[N];
+	uint32_t _buckets[N + 1] {};
+	uint32_t _count{0};
+	uint64_t _sum{0};
+	uint32_t _max{0};
+};
+
+class GPSStatistics
+{
+public:
+	GPSStatistics() = default;
+	~GPSStatistics();
+
+	/** poll() returned, with or without data */
+	void pollWakeup() { _poll_wakeups++; }
+
+	/** read() returned bytes */
+	void readDone(int bytes) { _read_size.add(bytes); }
+
+	/** the driver reported a message (GPSCallbackType::gotMessage) */
+	void messageReceived(const GPSMessageTiming &timing);
+
+	/** the position was published: measure the time since the epoch was complete */
+	void published();
+
+	/** update the rates, called periodically */
+	void updateRates(float dt);
+
+	void print_status();
+
+private:
+	static constexpr unsigned MAX_MESSAGE_TYPES = 12;	///< message types with a parse time counter
+
+	struct MessageType {
+		uint32_t msg_id;
+		char name[24];
+		perf_counter_t parse_perf;
+	};
+
+	/** @return the parse time counter of a message type, nullptr if the table is full */
+	perf_counter_t parsePerf(uint32_t msg_id);
+
+	static const uint32_t latency_limits[9];	///< [us]
+	static const uint32_t read_size_limits[7];	///< [bytes]
+
+	Histogram<9> _transport{latency_limits};	///< first byte to checksum complete
+	Histogram<9> _publish_delay{latency_limits};	///< epoch complete to publication
+	Histogram<7> _read_size{read_size_limits};
+
+	MessageType _message_types[MAX_MESSAGE_TYPES] {};
+	unsigned _num_message_types{0};
+
+	hrt_abstime _epoch_complete_time{0};	///< end of the handling of the last message completing a position
+
+	unsigned _poll_wakeups{0};
+	float _poll_rate{0.0f};			///< [Hz]
+};
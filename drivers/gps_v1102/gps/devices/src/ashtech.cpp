@@ -34,6 +34,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <stddef.h>
 #include <string.h>
 #include <ctime>
 #include <cmath>
@@ -53,11 +54,12 @@
 
 GPSDriverAshtech::GPSDriverAshtech(GPSCallbackPtr callback, void *callback_user,
 				   struct vehicle_gps_position_s *gps_position,
-				   struct satellite_info_s *satellite_info, float heading_offset) :
+				   struct satellite_info_s *satellite_info, float heading_offset, bool binary_output) :
 	GPSBaseStationSupport(callback, callback_user),
 	_satellite_info(satellite_info),
 	_gps_position(gps_position),
-	_heading_offset(heading_offset)
+	_heading_offset(heading_offset),
+	_binary_output(binary_output)
 {
 	decodeInit();
 }
@@ -91,7 +93,10 @@ int GPSDriverAshtech::handleMessage(int len)
 	char *bufptr = (char *)(_rx_buffer + 6);
 	int ret = 0;
 
-	if ((memcmp(_rx_buffer + 3, "ZDA,", 3) == 0) && (uiCalcComma == 6)) {
+	if (len == (int)ASH_PBN_MSG_LEN && memcmp(_rx_buffer, ASH_PBN_HEADER, ASH_PBN_HEADER_LEN) == 0) {
+		ret = handlePBN();
+
+	} else if ((memcmp(_rx_buffer + 3, "ZDA,", 3) == 0) && (uiCalcComma == 6)) {
 		/*
 		UTC day, month, and year, and local time zone offset
 		An example of the ZDA message string is:
@@ -135,46 +140,29 @@ int GPSDriverAshtech::handleMessage(int len)
 		/*
 		 * convert to unix timestamp
 		 */
-		struct tm timeinfo = {};
-		timeinfo.tm_year = year - 1900;
-		timeinfo.tm_mon = month - 1;
-		timeinfo.tm_mday = day;
-		timeinfo.tm_hour = ashtech_hour;
-		timeinfo.tm_min = ashtech_minute;
-		timeinfo.tm_sec = int(ashtech_sec);
-		timeinfo.tm_isdst = 0;
-
-#ifndef NO_MKTIME
-		time_t epoch = mktime(&timeinfo);
-
-		if (epoch > GPS_EPOCH_SECS) {
-			uint64_t usecs = static_cast<uint64_t>((ashtech_sec - static_cast<uint64_t>(ashtech_sec))) * 1000000;
+		const uint64_t time_utc_usec = utcTimeUsec(year, month, day, ashtech_hour * 3600 + ashtech_minute * 60 + ashtech_sec);
 
+		if (time_utc_usec > static_cast<uint64_t>(GPS_EPOCH_SECS) * 1000000ULL) {
 			// FMUv2+ boards have a hardware RTC, but GPS helps us to configure it
 			// and control its drift. Since we rely on the HRT for our monotonic
 			// clock, updating it from time to time is safe.
 
 			timespec ts{};
-			ts.tv_sec = epoch;
-			ts.tv_nsec = usecs * 1000;
+			ts.tv_sec = time_utc_usec / 1000000ULL;
+			ts.tv_nsec = (time_utc_usec % 1000000ULL) * 1000;
 
 			setClock(ts);
 
-			_gps_position->time_utc_usec = static_cast<uint64_t>(epoch) * 1000000ULL;
-			_gps_position->time_utc_usec += usecs;
+			_gps_position->time_utc_usec = time_utc_usec;
 
 		} else {
 			_gps_position->time_utc_usec = 0;
 		}
 
-#else
-		_gps_position->time_utc_usec = 0;
-#endif
-
 		_last_timestamp_time = gps_absolute_time();
 	}
 
-	else if ((memcmp(_rx_buffer + 3, "GGA,", 3) == 0) && (uiCalcComma == 14) && !_got_pashr_pos_message) {
+	else if ((memcmp(_rx_buffer + 3, "GGA,", 3) == 0) && (uiCalcComma == 14) && (!_got_pashr_pos_message || _binary_output)) {
 		/*
 		  Time, position, and fix related data
 		  An example of the GBS message string is:
@@ -212,12 +200,12 @@ int GPSDriverAshtech::handleMessage(int len)
 		  The checksum data, always begins with *
 		  Note - If a user-defined geoid model, or an inclined
 		*/
-		double ashtech_time = 0.0, lat = 0.0, lon = 0.0, alt = 0.0;
+		double ashtech_time = 0.0, lat = 0.0, lon = 0.0, alt = 0.0, geoid_separation = 0.0;
 		int num_of_sv = 0, fix_quality = 0;
 		double hdop = 99.9;
 		char ns = '?', ew = '?';
+		bool got_geoid_separation = false;
 
-		ASH_UNUSED(ashtech_time);
 		ASH_UNUSED(num_of_sv);
 		ASH_UNUSED(hdop);
 
@@ -239,6 +227,23 @@ int GPSDriverAshtech::handleMessage(int len)
 
 		if (bufptr && *(++bufptr) != ',') { alt = strtod(bufptr, &endp); bufptr = endp; }
 
+		if (bufptr && *(++bufptr) != ',') { bufptr++; } // unit of the altitude (M)
+
+		if (bufptr && *(++bufptr) != ',') {
+			geoid_separation = strtod(bufptr, &endp);
+			got_geoid_separation = bufptr != endp;
+			bufptr = endp;
+		}
+
+		if (_binary_output) {
+			// position & velocity are taken from PBN, this message is only requested for the geoid separation
+			if (got_geoid_separation) {
+				_geoid_separation = (float)geoid_separation;
+			}
+
+			return 0;
+		}
+
 		if (ns == 'S') {
 			lat = -lat;
 		}
@@ -270,6 +275,7 @@ int GPSDriverAshtech::handleMessage(int len)
 		}
 
 		_gps_position->timestamp = gps_absolute_time();
+		positionEpoch(ashtech_time);
 
 		_gps_position->vel_m_s = 0;                                  /**< GPS ground speed (m/s) */
 		_gps_position->vel_n_m_s = 0;                                /**< GPS ground speed in m/s */
@@ -281,7 +287,7 @@ int GPSDriverAshtech::handleMessage(int len)
 		_gps_position->c_variance_rad = 0.1f;
 		ret = 1;
 
-	} else if (memcmp(_rx_buffer, "$GPHDT,", 7) == 0 && uiCalcComma == 2) {
+	} else if (memcmp(_rx_buffer + 3, "HDT,", 4) == 0 && uiCalcComma >= 2) {
 		/*
 		Heading message
 		Example $GPHDT,121.2,T*35
@@ -290,21 +296,55 @@ int GPSDriverAshtech::handleMessage(int len)
 		T “T” for “True”
 		 */
 
-		float heading = 0.f;
-
 		if (bufptr && *(++bufptr) != ',') {
-			heading = strtof(bufptr, &endp); bufptr = endp;
+			float heading = strtof(bufptr, &endp); bufptr = endp;
 
 			ASH_DEBUG("heading update: %.3f", (double)heading);
 
-			heading *= M_PI_F / 180.0f; // deg to rad, now in range [0, 2pi]
-			heading -= _heading_offset; // range: [-pi, 3pi]
+			ret = handleHeading(heading, -1.);
+		}
 
-			if (heading > M_PI_F) {
-				heading -= 2.f * M_PI_F; // final range is [-pi, pi]
-			}
+	} else if (memcmp(_rx_buffer + 3, "THS,", 4) == 0 && uiCalcComma >= 2) {
+		/*
+		True heading and status
+		Example $GPTHS,121.2,A*cc
+
+		f1 Heading, in degrees (0-359.99)
+		c2 Mode: A autonomous, E estimated (dead reckoning), M manual, S simulator, V not valid
+		 */
+		float heading = 0.f;
+		char mode = 'V';
+
+		if (bufptr && *(++bufptr) != ',') { heading = strtof(bufptr, &endp); bufptr = endp; }
 
-			_gps_position->heading = heading;
+		if (bufptr && *(++bufptr) != ',') { mode = *(bufptr++); }
+
+		if (mode == 'A') {
+			ret = handleHeading(heading, -1.);
+		}
+
+	} else if (memcmp(_rx_buffer, "$PASHR,HPR,", 11) == 0 && uiCalcComma >= 5) {
+		/*
+		Heading, pitch and roll
+		Example $PASHR,HPR,125410.00,121.20,+0.50,,0.004,0.032,0,2,1*3A
+
+		m1 UTC time of the attitude (hhmmss.ss)
+		f2 True heading in degrees (0-359.99), empty if not available
+		f3 Pitch in degrees
+		f4 Roll in degrees
+		...
+		 */
+		bufptr = (char *)(_rx_buffer + 10);
+		double ashtech_time = -1.;
+
+		if (bufptr && *(++bufptr) != ',') { ashtech_time = strtod(bufptr, &endp); bufptr = endp; }
+
+		if (bufptr && *(++bufptr) != ',') {
+			float heading = strtof(bufptr, &endp);
+
+			if (bufptr != endp) {
+				ret = handleHeading(heading, ashtech_time);
+			}
 		}
 
 	} else if ((memcmp(_rx_buffer, "$PASHR,POS,", 11) == 0) && (uiCalcComma == 18)) {
@@ -350,7 +390,6 @@ int GPSDriverAshtech::handleMessage(int len)
 		double hdop = 99.9, vdop = 99.9,  pdop = 99.9, tdop = 99.9, vertic_vel = 0.0;
 		char ns = '?', ew = '?';
 
-		ASH_UNUSED(ashtech_time);
 		ASH_UNUSED(num_of_sv);
 		ASH_UNUSED(age_of_corr);
 		ASH_UNUSED(pdop);
@@ -418,38 +457,48 @@ int GPSDriverAshtech::handleMessage(int len)
 			lon = -lon;
 		}
 
-		_gps_position->lat = static_cast<int>((int(lat * 0.01) + (lat * 0.01 - int(lat * 0.01)) * 100.0 / 60.0) * 10000000);
-		_gps_position->lon = static_cast<int>((int(lon * 0.01) + (lon * 0.01 - int(lon * 0.01)) * 100.0 / 60.0) * 10000000);
-		_gps_position->alt = static_cast<int>(alt * 1000);
-		_gps_position->hdop = (float)hdop;
-		_gps_position->vdop = (float)vdop;
-		_rate_count_lat_lon++;
-
-		if (coordinatesFound < 3) {
-			_gps_position->fix_type = 0;
+		uint8_t fix_type = 0;
 
-		} else {
+		if (coordinatesFound >= 3) {
 			if (fix_quality == 9 || fix_quality == 10) { // SBAS differential or BeiDou differential
-				_gps_position->fix_type = 4; // use RTCM differential
+				fix_type = 4; // use RTCM differential
 
 			} else if (fix_quality == 12 || fix_quality == 22) { // RTK float or RTK float dithered
-				_gps_position->fix_type = 5;
+				fix_type = 5;
 
 			} else if (fix_quality == 13 || fix_quality == 23) { // RTK fixed or RTK fixed dithered
-				_gps_position->fix_type = 6;
+				fix_type = 6;
 
 			} else {
-				_gps_position->fix_type = 3 + fix_quality;
+				fix_type = 3 + fix_quality;
 			}
+		}
 
-			// we got a valid position, activate correction output if needed
-			if (_configure_done && _output_mode == OutputMode::RTCM &&
-			    _board == AshtechBoard::trimble_mb_two && !_correction_output_activated) {
-				activateCorrectionOutput();
-			}
+		if (_binary_output) {
+			// position & velocity are taken from PBN, this message is only requested for the solution status
+			_pos_fix_type = fix_type;
+			_pos_satellites_used = num_of_sv;
+			_pos_hdop = (float)hdop;
+			_pos_vdop = (float)vdop;
+			return 0;
+		}
+
+		_gps_position->lat = static_cast<int>((int(lat * 0.01) + (lat * 0.01 - int(lat * 0.01)) * 100.0 / 60.0) * 10000000);
+		_gps_position->lon = static_cast<int>((int(lon * 0.01) + (lon * 0.01 - int(lon * 0.01)) * 100.0 / 60.0) * 10000000);
+		_gps_position->alt = static_cast<int>(alt * 1000);
+		_gps_position->hdop = (float)hdop;
+		_gps_position->vdop = (float)vdop;
+		_gps_position->fix_type = fix_type;
+		_rate_count_lat_lon++;
+
+		// we got a valid position, activate correction output if needed
+		if (coordinatesFound >= 3 && _configure_done && _output_mode == OutputMode::RTCM &&
+		    _board == AshtechBoard::trimble_mb_two && !_correction_output_activated) {
+			activateCorrectionOutput();
 		}
 
 		_gps_position->timestamp = gps_absolute_time();
+		positionEpoch(ashtech_time);
 
 		float track_rad = static_cast<float>(track_true) * M_PI_F / 180.0f;
 
@@ -493,16 +542,16 @@ int GPSDriverAshtech::handleMessage(int len)
 		  8   Height 1 sigma error, in meters
 		  9   The checksum data, always begins with *
 		*/
-		double ashtech_time = 0.0, lat_err = 0.0, lon_err = 0.0, alt_err = 0.0;
+		double lat_err = 0.0, lon_err = 0.0, alt_err = 0.0;
 		double min_err = 0.0, maj_err = 0.0, deg_from_north = 0.0, rms_err = 0.0;
 
-		ASH_UNUSED(ashtech_time);
 		ASH_UNUSED(min_err);
 		ASH_UNUSED(maj_err);
 		ASH_UNUSED(deg_from_north);
 		ASH_UNUSED(rms_err);
 
-		if (bufptr && *(++bufptr) != ',') { ashtech_time = strtod(bufptr, &endp); bufptr = endp; }
+		// skip the UTC time, the errors are applied to the next position report
+		if (bufptr && *(++bufptr) != ',') { strtod(bufptr, &endp); bufptr = endp; }
 
 		if (bufptr && *(++bufptr) != ',') { rms_err = strtod(bufptr, &endp); bufptr = endp; }
 
@@ -725,6 +774,130 @@ int GPSDriverAshtech::handleMessage(int len)
 	return ret;
 }
 
+static inline uint16_t ashReadU16(const uint8_t *p)
+{
+	return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static inline uint32_t ashReadU32(const uint8_t *p)
+{
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline float ashReadFloat(const uint8_t *p)
+{
+	uint32_t u = ashReadU32(p);
+	float f;
+	memcpy(&f, &u, sizeof(f));
+	return f;
+}
+
+static inline double ashReadDouble(const uint8_t *p)
+{
+	uint64_t u = ((uint64_t)ashReadU32(p) << 32) | ashReadU32(p + 4);
+	double d;
+	memcpy(&d, &u, sizeof(d));
+	return d;
+}
+
+#define ASH_PBN_FIELD(buf, field) ((buf) + offsetof(ashtech_pbn_t, field))
+
+int GPSDriverAshtech::handlePBN()
+{
+	const uint8_t *pbn = _rx_buffer + ASH_PBN_HEADER_LEN;
+
+	const double ecef_x = ashReadDouble(ASH_PBN_FIELD(pbn, navx));
+	const double ecef_y = ashReadDouble(ASH_PBN_FIELD(pbn, navy));
+	const double ecef_z = ashReadDouble(ASH_PBN_FIELD(pbn, navz));
+
+	if (ecef_x == 0. && ecef_y == 0. && ecef_z == 0.) {
+		// no position computed yet
+		_gps_position->fix_type = 0;
+		return 0;
+	}
+
+	double latitude, longitude;
+	float altitude;
+	ECEF2lla(ecef_x, ecef_y, ecef_z, latitude, longitude, altitude);
+
+	_gps_position->timestamp = gps_absolute_time();
+	_gps_position->lat = static_cast<int32_t>(latitude * 1e7);
+	_gps_position->lon = static_cast<int32_t>(longitude * 1e7);
+	// the ECEF position gives the height above the ellipsoid, the MSL altitude needs the geoid separation from GGA
+	// (until the first GGA arrives the ellipsoid height is used)
+	const float geoid_separation = std::isfinite(_geoid_separation) ? _geoid_separation : 0.f;
+	_gps_position->alt_ellipsoid = static_cast<int32_t>(altitude * 1000.f);
+	_gps_position->alt = static_cast<int32_t>((altitude - geoid_separation) * 1000.f);
+	_gps_position->fix_type = _pos_fix_type;
+	_gps_position->satellites_used = _pos_satellites_used;
+	_gps_position->hdop = _pos_hdop;
+	_gps_position->vdop = _pos_vdop;
+	_rate_count_lat_lon++;
+
+	// rotate the ECEF velocity into the local NED frame
+	const float vx = ashReadFloat(ASH_PBN_FIELD(pbn, navxdot));
+	const float vy = ashReadFloat(ASH_PBN_FIELD(pbn, navydot));
+	const float vz = ashReadFloat(ASH_PBN_FIELD(pbn, navzdot));
+	const float lat_rad = static_cast<float>(latitude) * M_PI_F / 180.0f;
+	const float lon_rad = static_cast<float>(longitude) * M_PI_F / 180.0f;
+	const float sin_lat = sinf(lat_rad);
+	const float cos_lat = cosf(lat_rad);
+	const float sin_lon = sinf(lon_rad);
+	const float cos_lon = cosf(lon_rad);
+
+	const float vel_n = -sin_lat * cos_lon * vx - sin_lat * sin_lon * vy + cos_lat * vz;
+	const float vel_e = -sin_lon * vx + cos_lon * vy;
+	const float vel_d = -cos_lat * cos_lon * vx - cos_lat * sin_lon * vy - sin_lat * vz;
+
+	_gps_position->vel_n_m_s = vel_n;
+	_gps_position->vel_e_m_s = vel_e;
+	_gps_position->vel_d_m_s = vel_d;
+	_gps_position->vel_m_s = sqrtf(vel_n * vel_n + vel_e * vel_e);
+	_gps_position->cog_rad = atan2f(vel_e, vel_n);
+	_gps_position->vel_ned_valid = true;
+	_rate_count_vel++;
+
+	// PBN carries GPS time of week, which cannot be matched against UTC heading epochs
+	positionEpoch(-1.);
+
+	return 1;
+}
+
+int GPSDriverAshtech::handleHeading(float heading_deg, double epoch_time)
+{
+	float heading = heading_deg * M_PI_F / 180.0f; // deg to rad, now in range [0, 2pi]
+	heading -= _heading_offset; // range: [-pi, 3pi]
+
+	if (heading > M_PI_F) {
+		heading -= 2.f * M_PI_F; // final range is [-pi, pi]
+	}
+
+	if (!_got_position || (epoch_time >= 0. && _last_position_time >= 0. && epoch_time > _last_position_time)) {
+		// the position of this epoch did not arrive yet: attach it once it does
+		_pending_heading = heading;
+		_pending_heading_time = epoch_time;
+		return 0;
+	}
+
+	// heading of the last reported epoch: publish it now. The position timestamp is left unchanged, so that
+	// the estimator does not take the last position as a new sample.
+	_gps_position->heading = heading;
+	return 4;
+}
+
+void GPSDriverAshtech::positionEpoch(double epoch_time)
+{
+	_last_position_time = epoch_time;
+	_got_position = true;
+
+	// a heading of a later epoch (HPR ahead of its position) is kept for the position of that epoch
+	if (std::isfinite(_pending_heading)
+	    && (epoch_time < 0. || _pending_heading_time < 0. || _pending_heading_time <= epoch_time)) {
+		_gps_position->heading = _pending_heading;
+		_pending_heading = NAN;
+	}
+}
+
 void GPSDriverAshtech::activateRTCMOutput()
 {
 	char buffer[40];
@@ -778,6 +951,7 @@ int GPSDriverAshtech::receive(unsigned timeout)
 
 		int j = 0;
 		int bytes_count = 0;
+		int heading_updated = 0;
 
 		while (true) {
 
@@ -786,13 +960,20 @@ int GPSDriverAshtech::receive(unsigned timeout)
 				int l = 0;
 
 				if ((l = parseChar(buf[j])) > 0) {
+					const gps_abstime complete_time = gps_absolute_time();
 					/* return to configure during configuration or to the gps driver during normal work
 					 * if a packet has arrived */
 					int ret = handleMessage(l);
 
-					if (ret > 0) {
-						return ret;
+					reportMessage(messageId(l), _rx_start_time, complete_time, ret > 0 ? ret : 0);
+
+					if (ret > 0 && ret != 4) {
+						return ret | heading_updated;
 					}
+
+					/* a heading alone does not end the receive, the position of the epoch might follow in the
+					 * same buffer */
+					heading_updated |= ret & 4;
 				}
 
 				j++;
@@ -801,6 +982,10 @@ int GPSDriverAshtech::receive(unsigned timeout)
 			/* everything is read */
 			j = bytes_count = 0;
 
+			if (heading_updated) {
+				return heading_updated;
+			}
+
 			/* then poll or read for new data */
 			int ret = read(buf, sizeof(buf), timeout * 2);
 
@@ -827,6 +1012,13 @@ int GPSDriverAshtech::receive(unsigned timeout)
 }
 #define HEXDIGIT_CHAR(d) ((char)((d) + (((d) < 0xA) ? '0' : 'A'-0xA)))
 
+uint32_t GPSDriverAshtech::messageId(int len) const
+{
+	// proprietary sentences (binary PBN included) are identified by the type following "$PASHR,", e.g. "POS"
+	const int offset = (len >= 10 && memcmp(_rx_buffer, "$PASHR,", 7) == 0) ? 7 : 3;
+	return _rx_buffer[offset] << 16 | _rx_buffer[offset + 1] << 8 | _rx_buffer[offset + 2];
+}
+
 int GPSDriverAshtech::parseChar(uint8_t b)
 {
 	int iRet = 0;
@@ -838,6 +1030,7 @@ int GPSDriverAshtech::parseChar(uint8_t b)
 			_decode_state = NMEADecodeState::got_sync1;
 			_rx_buffer_bytes = 0;
 			_rx_buffer[_rx_buffer_bytes++] = b;
+			_rx_start_time = _read_time;
 
 		} else if (b == RTCM3_PREAMBLE && _rtcm_parsing) {
 			_decode_state = NMEADecodeState::decode_rtcm3;
@@ -851,6 +1044,7 @@ int GPSDriverAshtech::parseChar(uint8_t b)
 		if (b == '$') {
 			_decode_state = NMEADecodeState::got_sync1;
 			_rx_buffer_bytes = 0;
+			_rx_start_time = _read_time;
 
 		} else if (b == '*') {
 			_decode_state = NMEADecodeState::got_asteriks;
@@ -863,6 +1057,35 @@ int GPSDriverAshtech::parseChar(uint8_t b)
 
 		} else {
 			_rx_buffer[_rx_buffer_bytes++] = b;
+
+			// binary payload follows the PBN header, it cannot be parsed as text
+			if (_binary_output && _rx_buffer_bytes == ASH_PBN_HEADER_LEN &&
+			    memcmp(_rx_buffer, ASH_PBN_HEADER, ASH_PBN_HEADER_LEN) == 0) {
+				_decode_state = NMEADecodeState::decode_pbn;
+			}
+		}
+
+		break;
+
+	case NMEADecodeState::decode_pbn:
+		_rx_buffer[_rx_buffer_bytes++] = b;
+
+		if (_rx_buffer_bytes == ASH_PBN_MSG_LEN) {
+			const uint8_t *pbn = _rx_buffer + ASH_PBN_HEADER_LEN;
+			uint16_t checksum = 0;
+
+			for (unsigned i = 0; i < offsetof(ashtech_pbn_t, checksum); i += 2) {
+				checksum += ashReadU16(pbn + i);
+			}
+
+			if (checksum == ashReadU16(ASH_PBN_FIELD(pbn, checksum))) {
+				iRet = _rx_buffer_bytes;
+
+			} else {
+				ASH_DEBUG("PBN checksum error");
+			}
+
+			decodeInit();
 		}
 
 		break;
@@ -946,6 +1169,9 @@ int GPSDriverAshtech::configure(unsigned &baudrate, OutputMode output_mode)
 	_output_mode = output_mode;
 	_correction_output_activated = false;
 	_configure_done = false;
+	_got_position = false;
+	_last_position_time = -1.;
+	_pending_heading = NAN;
 
 	/* Try different baudrates (115200 is the default for Trimble) and request the baudrate that we want.
 	 *
@@ -1086,14 +1312,19 @@ int GPSDriverAshtech::configure(unsigned &baudrate, OutputMode output_mode)
 		}
 	}
 
+	const bool use_binary_output = _binary_output && output_mode == OutputMode::GPS;
+
 	char buffer[40];
 	const char *config_options[] = {
 		"$PASHS,NME,ALL,%c,OFF\r\n",    // disable all NMEA and NMEA-Like Messages
 		"$PASHS,ATM,ALL,%c,OFF\r\n",    // disable all ATM (ATOM) Messages
+		"$PASHS,RAW,ALL,%c,OFF\r\n",    // disable all raw data Messages
 		"$PASHS,OUT,%c,ON\r\n",         // enable periodic output
 		"$PASHS,NME,ZDA,%c,ON,3\r\n",   // enable ZDA (date & time) output every 3s
 		"$PASHS,NME,GST,%c,ON,3\r\n",   // position accuracy messages
-		"$PASHS,NME,POS,%c,ON,0.05\r\n",// position & velocity (we can go up to 20Hz if FW option [W] is given and to 50Hz if [8] is given)
+		// position & velocity (we can go up to 20Hz if FW option [W] is given and to 50Hz if [8] is given).
+		// In binary mode POS is only used for the solution status, position & velocity come from PBN.
+		use_binary_output ? "$PASHS,NME,POS,%c,ON,1\r\n" : "$PASHS,NME,POS,%c,ON,0.05\r\n",
 		"$PASHS,NME,GSV,%c,ON,1\r\n"    // satellite status
 	};
 
@@ -1106,9 +1337,27 @@ int GPSDriverAshtech::configure(unsigned &baudrate, OutputMode output_mode)
 		}
 	}
 
+	if (use_binary_output) {
+		// binary position & velocity at 20Hz
+		const char pbn_output[] = "$PASHS,RAW,PBN,%c,ON,0.05\r\n";
+		int len = snprintf(buffer, sizeof(buffer), pbn_output, _port);
+
+		if (writeAckedCommand(buffer, len, ASH_RESPONSE_TIMEOUT) != 0) {
+			ASH_DEBUG("command %s failed", buffer);
+		}
+
+		// GGA for the geoid separation, to convert the ellipsoid height of PBN to MSL altitude
+		const char gga_output[] = "$PASHS,NME,GGA,%c,ON,1\r\n";
+		len = snprintf(buffer, sizeof(buffer), gga_output, _port);
+
+		if (writeAckedCommand(buffer, len, ASH_RESPONSE_TIMEOUT) != 0) {
+			ASH_DEBUG("command %s failed", buffer);
+		}
+	}
+
 	if (use_dual_mode) {
-		// enable heading output
-		const char heading_output[] = "$PASHS,NME,HDT,%c,ON,0.05\r\n";
+		// enable heading output. HPR carries the epoch time, so it can be matched with the position
+		const char heading_output[] = "$PASHS,NME,HPR,%c,ON,0.05\r\n";
 		int len = snprintf(buffer, sizeof(buffer), heading_output, _port);
 
 		if (writeAckedCommand(buffer, len, ASH_RESPONSE_TIMEOUT) != 0) {
@@ -48,14 +48,43 @@ class RTCMParsing;
 
 #define ASH_RESPONSE_TIMEOUT	200		// ms, timeout for waiting for a response
 
+#define ASH_PBN_HEADER		"$PASHR,PBN,"
+#define ASH_PBN_HEADER_LEN	(sizeof(ASH_PBN_HEADER) - 1)
+
+#pragma pack(push, 1)
+
+/**
+ * PBN (position binary) message, sent as "$PASHR,PBN," followed by this fixed-size block.
+ * All fields are big endian.
+ */
+typedef struct {
+	int32_t		pbentime;	///< GPS time of week [ms]
+	char		sitename[4];	///< site name
+	double		navx;		///< ECEF X position [m]
+	double		navy;		///< ECEF Y position [m]
+	double		navz;		///< ECEF Z position [m]
+	float		navt;		///< clock offset [m]
+	float		navxdot;	///< ECEF X velocity [m/s]
+	float		navydot;	///< ECEF Y velocity [m/s]
+	float		navzdot;	///< ECEF Z velocity [m/s]
+	float		navtdot;	///< clock drift [m/s]
+	uint16_t	pdop;		///< PDOP [0.01]
+	uint16_t	checksum;	///< sum of all preceding 16 bit words
+} ashtech_pbn_t;
+
+#pragma pack(pop)
+
+#define ASH_PBN_MSG_LEN		(ASH_PBN_HEADER_LEN + sizeof(ashtech_pbn_t))
+
 class GPSDriverAshtech : public GPSBaseStationSupport
 {
 public:
 	/**
 	 * @param heading_offset heading offset in radians [-pi, pi]. It is substracted from the measurement.
+	 * @param binary_output if true, position and velocity are requested as binary PBN messages instead of $PASHR,POS
 	 */
 	GPSDriverAshtech(GPSCallbackPtr callback, void *callback_user, struct vehicle_gps_position_s *gps_position,
-			 struct satellite_info_s *satellite_info, float heading_offset = 0.f);
+			 struct satellite_info_s *satellite_info, float heading_offset = 0.f, bool binary_output = false);
 	virtual ~GPSDriverAshtech();
 
 	int receive(unsigned timeout) override;
@@ -81,7 +110,8 @@ private:
 		got_sync1,
 		got_asteriks,
 		got_first_cs_byte,
-		decode_rtcm3
+		decode_rtcm3,
+		decode_pbn
 	};
 
 	enum class AshtechBoard {
@@ -91,6 +121,34 @@ private:
 
 	void decodeInit(void);
 	int handleMessage(int len);
+
+	/**
+	 * decode a PBN message from _rx_buffer
+	 * @return 1 if the position was updated, 0 otherwise
+	 */
+	int handlePBN();
+
+	/**
+	 * @return the identifier of the message in _rx_buffer for the statistics: the sentence type without the
+	 * talker id (e.g. "GGA") or the type of a $PASHR message (e.g. "POS", "PBN")
+	 */
+	uint32_t messageId(int len) const;
+
+	/**
+	 * handle a new heading measurement. A heading of the last reported position epoch is published right away,
+	 * with the unchanged position timestamp, so that the position is not taken as a new sample. A heading that
+	 * arrives ahead of its position is kept until the position of the same epoch arrives.
+	 * @param heading_deg true heading [deg]
+	 * @param epoch_time UTC time of the measurement (hhmmss.ss), <0 if unknown
+	 * @return 4 if the report should be published for the heading, 0 otherwise
+	 */
+	int handleHeading(float heading_deg, double epoch_time);
+
+	/**
+	 * store the epoch of a new position report and attach a pending heading that is not from a later epoch
+	 * @param epoch_time UTC time of the position (hhmmss.ss), <0 if unknown
+	 */
+	void positionEpoch(double epoch_time);
 	int parseChar(uint8_t b);
 
 	/**
@@ -123,6 +181,7 @@ private:
 	NMEADecodeState _decode_state{NMEADecodeState::uninit};
 	uint8_t _rx_buffer[ASHTECH_RECV_BUFFER_SIZE];
 	uint16_t _rx_buffer_bytes{};
+	gps_abstime _rx_start_time{0}; /**< read time of the first byte of the message being received */
 	bool _got_pashr_pos_message{false}; /**< If we got a PASHR,POS message, we will ignore GGA messages */
 
 	NMEACommand _waiting_for_command;
@@ -139,5 +198,20 @@ private:
 	bool _configure_done{false};
 
 	float _heading_offset;
+
+	const bool _binary_output; /**< use PBN binary messages for position & velocity */
+
+	float _pending_heading{NAN}; /**< heading waiting for its position report [rad] */
+	double _pending_heading_time{-1.}; /**< epoch of _pending_heading (hhmmss.ss), <0 if unknown */
+	double _last_position_time{-1.}; /**< epoch of the last position report (hhmmss.ss), <0 if unknown */
+	bool _got_position{false};
+
+	/** solution status from the low-rate $PASHR,POS message, used to complete PBN reports */
+	uint8_t _pos_fix_type{0};
+	uint8_t _pos_satellites_used{0};
+	float _pos_hdop{99.9f};
+	float _pos_vdop{99.9f};
+
+	float _geoid_separation{NAN}; /**< geoid separation from GGA, used for the MSL altitude of PBN [m] */
 };
 
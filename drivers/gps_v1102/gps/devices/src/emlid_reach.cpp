@@ -60,16 +60,21 @@
 #define ERB_ID_NAV_STATUS      0x03
 #define ERB_ID_DOPS            0x04
 #define ERB_ID_VELOCITY_NED    0x05
-#define ERB_ID_SPACE_INFO      0x06 // not used, reduces stack usage
-#define ERB_ID_RTK             0x07 // RTK, TODO
+#define ERB_ID_SPACE_INFO      0x06 // decoded while receiving, see payloadRxAddSpaceInfo()
+#define ERB_ID_RTK             0x07
 
 
 #define EMLID_UNUSED(x) (void)x;
 
+#define MIN(X,Y)	((X) < (Y) ? (X) : (Y))
+
 #define GPS_PI 3.141592653589793238462643383280f
 
 #define AUTO_DETECT_MAX_READ_SENTENCE 5  // if more detect succeed
 
+#define ERB_RTK_MAX_CORRECTION_AGE_MS 10000  // RTK solutions with older corrections are reported as DGPS
+#define ERB_RTK_AGE_OVERFLOW 0xFFFF  // age of corrections too large to be represented
+
 
 GPSDriverEmlidReach::GPSDriverEmlidReach(GPSCallbackPtr callback, void *callback_user,
 		struct vehicle_gps_position_s *gps_position, struct satellite_info_s *satellite_info) :
@@ -97,7 +102,9 @@ GPSDriverEmlidReach::configure(unsigned &baudrate, OutputMode output_mode)
 		_sentence_cnt = 0;
 		_erb_decode_state  = ERB_State::init;
 		_erb_payload_len = 0;
+		_erb_payload_index = 0;
 		_erb_buff_cnt = 0;
+		_rtk_received = false;
 
 		if (GPSHelper::setBaudrate(baud_allowed[i]) != 0) {
 			continue;
@@ -153,7 +160,10 @@ GPSDriverEmlidReach::receive(unsigned timeout)
 
 				// when testig connection, we care about syntax not semantic
 				if (! _testing_connection) {
-					return_status = handleErbSentence();
+					const gps_abstime complete_time = gps_absolute_time();
+					const int handled = handleErbSentence();
+					reportMessage(_erb_buff.header.id, _rx_start_time, complete_time, handled);
+					return_status |= handled;
 				}
 			}
 		}
@@ -186,6 +196,7 @@ GPSDriverEmlidReach::erbParseChar(uint8_t b)
 		if (b == ERB_SYNC_1) {
 			_erb_buff_cnt = 0;
 			buff_ptr[_erb_buff_cnt ++] = b;
+			_rx_start_time = _read_time;
 			_erb_decode_state = ERB_State::got_sync_1;
 		}
 
@@ -205,13 +216,10 @@ GPSDriverEmlidReach::erbParseChar(uint8_t b)
 	case ERB_State::got_sync_2:
 		if (b >= ERB_ID_VERSION && b <= ERB_ID_RTK) {
 			buff_ptr[_erb_buff_cnt ++] = b;
+			_erb_ck_a = b;
+			_erb_ck_b = b;
 			_erb_decode_state = ERB_State::got_id;
 
-			if (b == ERB_ID_SPACE_INFO || b == ERB_ID_RTK) {
-				//ignore those
-				_erb_decode_state = ERB_State::init;
-			}
-
 		} else {
 			_erb_decode_state = ERB_State::init;
 		}
@@ -220,25 +228,37 @@ GPSDriverEmlidReach::erbParseChar(uint8_t b)
 
 	case ERB_State::got_id:
 		buff_ptr[_erb_buff_cnt ++] = b;
+		_erb_ck_a += b;
+		_erb_ck_b += _erb_ck_a;
 		_erb_decode_state = ERB_State::got_len_1;
 		_erb_payload_len = b;
 		break;
 
 	case ERB_State::got_len_1:
 		buff_ptr[_erb_buff_cnt ++] = b;
+		_erb_ck_a += b;
+		_erb_ck_b += _erb_ck_a;
 		_erb_decode_state = ERB_State::got_len_2;
 		_erb_payload_len = (b << 8) | _erb_payload_len;
+		_erb_payload_index = 0;
 		break;
 
 	case ERB_State::got_len_2:
-		if (_erb_buff_cnt > ERB_SENTENCE_MAX_LEN - sizeof(erb_checksum_t)) {
+		_erb_ck_a += b;
+		_erb_ck_b += _erb_ck_a;
+
+		if (_erb_buff.header.id == ERB_ID_SPACE_INFO) {
+			payloadRxAddSpaceInfo(b);
+
+		} else if (_erb_buff_cnt > ERB_SENTENCE_MAX_LEN - sizeof(erb_checksum_t)) {
 			_erb_decode_state = ERB_State::init;
+			break;
 
 		} else {
 			buff_ptr[_erb_buff_cnt ++] = b;
 		}
 
-		if (_erb_buff_cnt >= _erb_payload_len + static_cast<unsigned>(ERB_HEADER_LEN)) {
+		if (++_erb_payload_index >= _erb_payload_len) {
 			_erb_decode_state = ERB_State::got_payload;
 		}
 
@@ -252,14 +272,7 @@ GPSDriverEmlidReach::erbParseChar(uint8_t b)
 	case ERB_State::got_CK_A:
 		_erb_checksum.ck_b = b;
 
-		uint8_t cka = 0, ckb = 0;
-
-		for (unsigned i = 2; i < _erb_payload_len + static_cast<unsigned>(ERB_HEADER_LEN); i++) {
-			cka += buff_ptr[i];
-			ckb += cka;
-		}
-
-		if (cka == _erb_checksum.ck_a && ckb == _erb_checksum.ck_b) {
+		if (_erb_ck_a == _erb_checksum.ck_a && _erb_ck_b == _erb_checksum.ck_b) {
 			ret = 1;
 
 		} else {
@@ -273,6 +286,70 @@ GPSDriverEmlidReach::erbParseChar(uint8_t b)
 	return ret;
 }
 
+void
+GPSDriverEmlidReach::payloadRxAddSpaceInfo(uint8_t b)
+{
+	uint8_t *p_payload = (uint8_t *)&_erb_buff.payload;
+
+	if (_erb_payload_index < sizeof(erb_space_info_part1_t)) {
+		// Fill Part 1 buffer
+		p_payload[_erb_payload_index] = b;
+
+		if (_erb_payload_index == sizeof(erb_space_info_part1_t) - 1 && _satellite_info) {
+			// Part 1 complete: decode Part 1 buffer
+			_satellite_info->count = MIN(_erb_buff.payload.space_info_part1.numberSV,
+						     satellite_info_s::SAT_INFO_MAX_SATELLITES);
+		}
+
+		return;
+	}
+
+	if (_satellite_info == nullptr) {
+		return;
+	}
+
+	unsigned block_offset = _erb_payload_index - sizeof(erb_space_info_part1_t);
+	unsigned sat_index = block_offset / sizeof(erb_space_info_part2_t);
+
+	if (sat_index >= _satellite_info->count) {
+		// no room left in _satellite_info, skip the remaining blocks
+		return;
+	}
+
+	// Fill Part 2 buffer (reuses the payload buffer, Part 1 has already been decoded)
+	unsigned buf_index = block_offset % sizeof(erb_space_info_part2_t);
+	p_payload[buf_index] = b;
+
+	if (buf_index == sizeof(erb_space_info_part2_t) - 1) {
+		// Part 2 complete: decode Part 2 buffer
+		const erb_space_info_part2_t &sv = _erb_buff.payload.space_info_part2;
+		int16_t azimuth = sv.azimuth;
+
+		if (azimuth < 0) {
+			azimuth += 360;
+		}
+
+		// ERB only reports tracked satellites, consider those with an L1 signal as used
+		_satellite_info->used[sat_index]	= (sv.signalL1 > 0) ? 1 : 0;
+		_satellite_info->snr[sat_index]		= sv.signalL1;
+		_satellite_info->elevation[sat_index]	= (uint8_t)((sv.elevation > 0) ? sv.elevation : 0);
+		_satellite_info->azimuth[sat_index]	= (uint8_t)((float)azimuth * 255.0f / 360.0f);
+		_satellite_info->svid[sat_index]	= sv.idSV;
+	}
+}
+
+uint8_t
+GPSDriverEmlidReach::fixTypeWithRTK() const
+{
+	// RTK float/fix (5/6): don't claim an RTK solution once corrections are stale or the base is lost
+	if (_fix_type >= 5 && _rtk_received
+	    && (_rtk_age_corrections_ms > ERB_RTK_MAX_CORRECTION_AGE_MS || _rtk_num_sat_base == 0)) {
+		return 4;
+	}
+
+	return _fix_type;
+}
+
 int
 GPSDriverEmlidReach::handleErbSentence()
 {
@@ -300,7 +377,7 @@ GPSDriverEmlidReach::handleErbSentence()
 		_gps_position->hdop = _hdop;
 		_gps_position->vdop = _vdop;
 		_gps_position->satellites_used = _satellites_used;
-		_gps_position->fix_type = _fix_type;
+		_gps_position->fix_type = fixTypeWithRTK();
 
 		_POS_received = true;
 
@@ -356,8 +433,22 @@ GPSDriverEmlidReach::handleErbSentence()
 
 	} else if (_erb_buff.header.id == ERB_ID_SPACE_INFO) {
 
+		// _satellite_info already populated by payloadRxAddSpaceInfo(), just add a timestamp
+		if (_satellite_info) {
+			_satellite_info->timestamp = gps_absolute_time();
+			ret = 2;
+		}
+
 	} else if (_erb_buff.header.id == ERB_ID_RTK) {
 
+		if (_erb_payload_len == sizeof(erb_rtk_t) - sizeof(erb_checksum_t)) {
+			const uint16_t age_corrections = _erb_buff.payload.rtk.ageCorrections;
+
+			_rtk_num_sat_base = _erb_buff.payload.rtk.numSatBase;
+			_rtk_age_corrections_ms = (age_corrections == ERB_RTK_AGE_OVERFLOW) ? UINT32_MAX : age_corrections * 10;
+			_rtk_received = true;
+		}
+
 	} else {
 		//GPS_WARN("EMLIDREACH: ERB ID not known: %d", _erb_buff.header.id);
 	}
@@ -366,7 +457,7 @@ GPSDriverEmlidReach::handleErbSentence()
 	if (_fix_status == 1
 	    && _POS_received && _VEL_received
 	    && _last_POS_timeGPS == _last_VEL_timeGPS) {
-		ret = 1;
+		ret |= 1;
 		_POS_received = false;
 		_VEL_received = false;
 	}
@@ -47,7 +47,8 @@
 //   https://files.emlid.com/ERB.pdf
 
 #define ERB_HEADER_LEN           5
-// Not using ERB_ID_SPACE_INFO, so use a smaller buff length
+// ERB_ID_SPACE_INFO is decoded block by block while it is received, so the
+// buffer only needs to hold the largest fixed-size message
 #define ERB_SENTENCE_MAX_LEN     (sizeof(erb_message_t))
 
 #define MAX_CONST(a, b) ((a>b) ? a : b)
@@ -115,12 +116,46 @@ typedef struct {
 	erb_checksum_t	checksum;
 } erb_ned_velocity_t;
 
+/* Rx SPACE_INFO Part 1 */
+typedef struct {
+	uint32_t		timeGPS;
+	uint8_t			numberSV;
+} erb_space_info_part1_t;
+
+/* Rx SPACE_INFO Part 2 (repeated) */
+typedef struct {
+	uint8_t			idSV;			/**< Satellite PRN */
+	uint8_t			typeSV;			/**< GNSS type: 0 GPS, 1 GLONASS, 2 Galileo, 3 QZSS, 4 BeiDou, 5 SBAS */
+	uint8_t			signalL1;		/**< Carrier to noise ratio on L1 [dB-Hz] */
+	uint8_t			signalL2;		/**< Carrier to noise ratio on L2 [dB-Hz] */
+	int32_t			carrierPhase;	/**< Carrier phase [cycles * 1e-2] */
+	int32_t			pseudoRange;	/**< Pseudorange [cm] */
+	int32_t			freqDoppler;	/**< Doppler [Hz * 1e-3] */
+	int16_t			azimuth;		/**< Azimuth [deg] */
+	int16_t			elevation;		/**< Elevation [deg] */
+} erb_space_info_part2_t;
+
+typedef struct {
+	uint8_t			numSatBase;			/**< Number of satellites used from the base */
+	uint16_t		ageCorrections;		/**< Age of differential corrections [10 ms], 0xFFFF on overflow */
+	int32_t			baselineN;			/**< Baseline to the base, north component [mm] */
+	int32_t			baselineE;			/**< Baseline to the base, east component [mm] */
+	int32_t			baselineD;			/**< Baseline to the base, down component [mm] */
+	uint16_t		arRatio;			/**< Ambiguity resolution ratio [0.1] */
+	uint16_t		weekGPS;			/**< Base GPS week */
+	uint32_t		timeGPS;			/**< Base GPS time of week [ms] */
+	erb_checksum_t	checksum;
+} erb_rtk_t;
+
 typedef union {
 	erb_version_t			version;
 	erb_geodic_position_t	geodic_position;
 	erb_navigation_status_t	navigation_status;
 	erb_dop_t				dop;
 	erb_ned_velocity_t		ned_velocity;
+	erb_space_info_part1_t	space_info_part1;
+	erb_space_info_part2_t	space_info_part2;
+	erb_rtk_t				rtk;
 } erb_payload_t;
 
 typedef struct {
@@ -169,11 +204,17 @@ private:
 	/** Buffer used by parser to build ERB sentences */
 	erb_message_t _erb_buff;
 	uint16_t _erb_buff_cnt;
+	/** read time of the first byte of the sentence being received */
+	gps_abstime _rx_start_time{0};
 
 	/** Buffer used by parser to build ERB checksum */
 	erb_checksum_t _erb_checksum;
 	uint8_t _erb_checksum_cnt;
 
+	/** Running checksum, updated as bytes are received */
+	uint8_t _erb_ck_a{0};
+	uint8_t _erb_ck_b{0};
+
 	/** Pointer provided by caller, ie gps.cpp */
 	struct vehicle_gps_position_s *_gps_position {nullptr};
 	/** Pointer provided by caller, gps.cpp */
@@ -184,6 +225,8 @@ private:
 	unsigned _sentence_cnt{0};
 
 	uint16_t _erb_payload_len{0};
+	/** number of payload bytes received for the current sentence */
+	uint16_t _erb_payload_index{0};
 
 	uint32_t _last_POS_timeGPS{0};
 	uint32_t _last_VEL_timeGPS{0};
@@ -198,12 +241,25 @@ private:
 	float _hdop{0};
 	float _vdop{0};
 
+	///// ERB RTK cache /////
+	uint8_t _rtk_num_sat_base{0};
+	uint32_t _rtk_age_corrections_ms{0};
+	bool _rtk_received{false};
+
 
 	/** Feed ERB parser with received bytes from serial
 	 * @return len of decoded message, 0 if not completed, -1 if error
 	 */
 	int erbParseChar(uint8_t b);
 
+	/** Add a SPACE_INFO payload byte, decoding each repeated block into satellite_info_s as soon as it is complete
+	 *  instead of buffering the whole message
+	 */
+	void payloadRxAddSpaceInfo(uint8_t b);
+
+	/** Fix type to report, taking the RTK correction status into account */
+	uint8_t fixTypeWithRTK() const;
+
 	/** ERB sentence into vehicle_gps_position_s or satellite_info_s, to be used by GPSHelper
 	 *  @return 1 if gps_position updated, 2 for satellite_info_s (can be bit OR), 0 for nothing
 	 */
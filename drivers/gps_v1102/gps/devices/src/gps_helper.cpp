@@ -100,3 +100,22 @@ void GPSHelper::ECEF2lla(double ecef_x, double ecef_y, double ecef_z, double &la
 
 	// correction for altitude near poles left out.
 }
+
+uint64_t GPSHelper::utcTimeUsec(int year, int month, int day, double seconds)
+{
+	static_assert(daysFromCivil(1970, 1, 1) == 0, "daysFromCivil");
+	static_assert(daysFromCivil(2000, 3, 1) == 11017, "daysFromCivil");
+
+	if (year < 1970 || month < 1 || month > 12 || day < 1 || day > 31 || seconds < 0.0 || seconds >= 86401.0) {
+		return 0;
+	}
+
+	const int32_t date = year * 10000 + month * 100 + day;
+
+	if (date != _utc_date) {
+		_utc_date_days = daysFromCivil(year, month, day);
+		_utc_date = date;
+	}
+
+	return static_cast<uint64_t>(_utc_date_days) * 86400000000ULL + static_cast<uint64_t>(seconds * 1e6 + 0.5);
+}
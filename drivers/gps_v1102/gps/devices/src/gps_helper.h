@@ -96,6 +96,23 @@ enum class GPSCallbackType {
 	 * return: ignored
 	 */
 	setClock,
+
+	/**
+	 * Got a chunk of the receiver's navigation database (e.g. u-blox MGA-DBD). It can be stored and
+	 * given back to the receiver with GPSHelper::restoreNavDatabase() after a restart.
+	 * data1: pointer to the chunk
+	 * data2: chunk length
+	 * return: ignored
+	 */
+	gotNavDatabase,
+
+	/**
+	 * A message was received and handled, reported for the latency statistics
+	 * data1: points to a GPSMessageTiming struct
+	 * data2: ignored
+	 * return: ignored
+	 */
+	gotMessage,
 };
 
 enum class GPSRestartType {
@@ -141,6 +158,24 @@ struct SurveyInStatus {
 	uint8_t flags;                /**< bit 0: valid, bit 1: active */
 };
 
+/** Timing of a received message */
+struct GPSMessageTiming {
+	uint32_t msg_id;              /**< protocol specific message identifier */
+	uint64_t first_byte_time;     /**< time of the read() that returned the first byte of the message [us] */
+	uint64_t complete_time;       /**< time at which the message was complete and its checksum verified [us] */
+	uint32_t parse_duration;      /**< time spent handling the message after the checksum [us] */
+	int handled;                  /**< bitset as returned by GPSHelper::receive(), for this message */
+};
+
+/** Last known receiver state, used to aid the receiver after a restart */
+struct GPSReceiverState {
+	uint64_t time_utc_usec;       /**< UTC time of the snapshot [us] */
+	int32_t lat;                  /**< [1e-7 deg] */
+	int32_t lon;                  /**< [1e-7 deg] */
+	int32_t alt_ellipsoid;        /**< [mm] */
+	uint32_t pos_accuracy;        /**< [mm] */
+};
+
 // TODO: this number seems wrong
 #define GPS_EPOCH_SECS ((time_t)1234567890ULL)
 
@@ -175,6 +210,8 @@ public:
 	 * @return <0 on error, otherwise a bitset:
 	 *         bit 0 set: got gps position update
 	 *         bit 1 set: got satellite info update
+	 *         bit 2 set: got heading update of the last reported position, the position and its timestamp are
+	 *                    unchanged (only if bit 0 is not set)
 	 */
 	virtual int receive(unsigned timeout) = 0;
 
@@ -187,6 +224,33 @@ public:
 	 */
 	virtual int reset(GPSRestartType restart_type)	{ return -1; }
 
+	/**
+	 * Aid the receiver with a previously stored position and the current time, to speed up the time to first fix.
+	 * Must be called after configure().
+	 * @param state last known receiver state
+	 * @param time_utc_usec current UTC time [us], 0 if unknown
+	 * @return <0 failure
+	 *         -1 not implemented
+	 *          0 success
+	 */
+	virtual int aidReceiverState(const GPSReceiverState &state, uint64_t time_utc_usec) { return -1; }
+
+	/**
+	 * Request a dump of the navigation database. The data is reported through GPSCallbackType::gotNavDatabase.
+	 * @return <0 failure
+	 *         -1 not implemented
+	 *          0 success
+	 */
+	virtual int requestNavDatabase() { return -1; }
+
+	/**
+	 * Send a navigation database chunk (as reported through GPSCallbackType::gotNavDatabase) back to the device
+	 * @return <0 failure
+	 *         -1 not implemented
+	 *          0 success
+	 */
+	virtual int restoreNavDatabase(const uint8_t *data, int data_length) { return -1; }
+
 	float getPositionUpdateRate() { return _rate_lat_lon; }
 	float getVelocityUpdateRate() { return _rate_vel; }
 	void resetUpdateRates();
@@ -206,7 +270,13 @@ protected:
 	int read(uint8_t *buf, int buf_length, int timeout)
 	{
 		*((int *)buf) = timeout;
-		return _callback(GPSCallbackType::readDeviceData, buf, buf_length, _callback_user);
+		const int ret = _callback(GPSCallbackType::readDeviceData, buf, buf_length, _callback_user);
+
+		if (ret > 0) {
+			_read_time = gps_absolute_time();
+		}
+
+		return ret;
 	}
 
 	/**
@@ -246,6 +316,30 @@ protected:
 		_callback(GPSCallbackType::setClock, &t, 0, _callback_user);
 	}
 
+	/**
+	 * Report the timing of a handled message. Call right after handling it.
+	 * @param msg_id protocol specific message identifier
+	 * @param first_byte_time time of the read() that returned the first byte (_read_time at that point)
+	 * @param complete_time time at which the checksum was verified, before handling the message
+	 * @param handled return value of the message handler
+	 */
+	void reportMessage(uint32_t msg_id, gps_abstime first_byte_time, gps_abstime complete_time, int handled)
+	{
+		GPSMessageTiming timing;
+		timing.msg_id = msg_id;
+		timing.first_byte_time = first_byte_time;
+		timing.complete_time = complete_time;
+		timing.parse_duration = gps_absolute_time() - complete_time;
+		timing.handled = handled;
+		_callback(GPSCallbackType::gotMessage, &timing, 0, _callback_user);
+	}
+
+	/** got a navigation database chunk from the device */
+	void gotNavDatabase(uint8_t *buf, int buf_length)
+	{
+		_callback(GPSCallbackType::gotNavDatabase, buf, buf_length, _callback_user);
+	}
+
 	/**
 	 * Convert an ECEF (Earth Centered Earth Fixed) coordinate to LLA WGS84 (Lat, Lon, Alt).
 	 * Ported from: https://stackoverflow.com/a/25428344
@@ -258,6 +352,34 @@ protected:
 	 */
 	static void ECEF2lla(double ecef_x, double ecef_y, double ecef_z, double &latitude, double &longitude, float &altitude);
 
+	/**
+	 * Number of days from 1970-01-01 to a date of the (proleptic) Gregorian calendar.
+	 * Algorithm 'days_from_civil' from: http://howardhinnant.github.io/date_algorithms.html
+	 * @param year e.g. 2020
+	 * @param month 1-12
+	 * @param day 1-31
+	 */
+	static constexpr int32_t daysFromCivil(int32_t year, uint32_t month, uint32_t day)
+	{
+		year -= month <= 2 ? 1 : 0;
+		const int32_t era = (year >= 0 ? year : year - 399) / 400;
+		const uint32_t year_of_era = static_cast<uint32_t>(year - era * 400);				// [0, 399]
+		const uint32_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;	// [0, 365]
+		const uint32_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year; // [0, 146096]
+		return era * 146097 + static_cast<int32_t>(day_of_era) - 719468;
+	}
+
+	/**
+	 * Convert a UTC date and time to microseconds since the Unix epoch. This replaces mktime(), which
+	 * depends on the time zone and is slow. The date part is cached, as it only changes once a day.
+	 * @param year e.g. 2020
+	 * @param month 1-12
+	 * @param day 1-31
+	 * @param seconds seconds since midnight
+	 * @return UTC time [us], 0 if the date is invalid
+	 */
+	uint64_t utcTimeUsec(int year, int month, int day, double seconds);
+
 	GPSCallbackPtr _callback{nullptr};
 	void *_callback_user{};
 
@@ -268,4 +390,9 @@ protected:
 	float _rate_vel{0.0f};
 
 	uint64_t _interval_rate_start{0};
+
+	gps_abstime _read_time{0};	///< time of the last read() that returned data
+
+	int32_t _utc_date{-1};		///< date of _utc_date_days, as yyyymmdd
+	int32_t _utc_date_days{0};	///< days since the Unix epoch of _utc_date
 };
@@ -40,6 +40,7 @@
 #include <ctime>
 
 #include "nmea.h"
+#include "ubx.h"
 #include <systemlib/mavlink_log.h>
 
 extern orb_advert_t mavlink_log_pub;
@@ -123,42 +124,25 @@ int GPSDriverNMEA::handleMessage(int len)
 		/*
 		 * convert to unix timestamp
 		 */
-		struct tm timeinfo = {};
-		timeinfo.tm_year = year - 1900;
-		timeinfo.tm_mon = month - 1;
-		timeinfo.tm_mday = day;
-		timeinfo.tm_hour = nmea_hour;
-		timeinfo.tm_min = nmea_minute;
-		timeinfo.tm_sec = int(nmea_sec);
-		timeinfo.tm_isdst = 0;
-
-#ifndef NO_MKTIME
-		time_t epoch = mktime(&timeinfo);
-
-		if (epoch > GPS_EPOCH_SECS) {
-			uint64_t usecs = static_cast<uint64_t>((nmea_sec - static_cast<uint64_t>(nmea_sec))) * 1000000;
+		const uint64_t time_utc_usec = utcTimeUsec(year, month, day, nmea_hour * 3600 + nmea_minute * 60 + nmea_sec);
 
+		if (time_utc_usec > static_cast<uint64_t>(GPS_EPOCH_SECS) * 1000000ULL) {
 			// FMUv2+ boards have a hardware RTC, but GPS helps us to configure it
 			// and control its drift. Since we rely on the HRT for our monotonic
 			// clock, updating it from time to time is safe.
 
 			timespec ts{};
-			ts.tv_sec = epoch;
-			ts.tv_nsec = usecs * 1000;
+			ts.tv_sec = time_utc_usec / 1000000ULL;
+			ts.tv_nsec = (time_utc_usec % 1000000ULL) * 1000;
 
 			setClock(ts);
 
-			_gps_position->time_utc_usec = static_cast<uint64_t>(epoch) * 1000000ULL;
-			_gps_position->time_utc_usec += usecs;
+			_gps_position->time_utc_usec = time_utc_usec;
 
 		} else {
 			_gps_position->time_utc_usec = 0;
 		}
 
-#else
-		_gps_position->time_utc_usec = 0;
-#endif
-
 		_last_timestamp_time = gps_absolute_time();
 
 	}	else if ((memcmp(_rx_buffer + 3, "GGA,", 3) == 0) && (uiCalcComma == 14)) {
@@ -439,41 +423,25 @@ FieldNo.  Name    Unit     Format                  Example Description
 		/*
 		 * convert to unix timestamp
 		 */
-		struct tm timeinfo = {};
-		timeinfo.tm_year = nmea_year + 2000;
-		timeinfo.tm_mon = nmea_mth;
-		timeinfo.tm_mday = nema_day;
-		timeinfo.tm_hour = nmea_hour;
-		timeinfo.tm_min = nmea_minute;
-		timeinfo.tm_sec = int(nmea_sec);
-		timeinfo.tm_isdst = 0;
-
-#ifndef NO_MKTIME
-		time_t epoch = mktime(&timeinfo);
-
-		if (epoch > GPS_EPOCH_SECS) {
-			uint64_t usecs = static_cast<uint64_t>((nmea_sec - static_cast<uint64_t>(nmea_sec))) * 1000000;
+		const uint64_t time_utc_usec = utcTimeUsec(2000 + nmea_year, nmea_mth, nema_day,
+					       nmea_hour * 3600 + nmea_minute * 60 + nmea_sec);
 
+		if (time_utc_usec > static_cast<uint64_t>(GPS_EPOCH_SECS) * 1000000ULL) {
 			// FMUv2+ boards have a hardware RTC, but GPS helps us to configure it
 			// and control its drift. Since we rely on the HRT for our monotonic
 			// clock, updating it from time to time is safe.
 
 			timespec ts{};
-			ts.tv_sec = epoch;
-			ts.tv_nsec = usecs * 1000;
+			ts.tv_sec = time_utc_usec / 1000000ULL;
+			ts.tv_nsec = (time_utc_usec % 1000000ULL) * 1000;
 
 			setClock(ts);
 
-			_gps_position->time_utc_usec = static_cast<uint64_t>(epoch) * 1000000ULL;
-			_gps_position->time_utc_usec += usecs;
+			_gps_position->time_utc_usec = time_utc_usec;
 
 		} else {
 			_gps_position->time_utc_usec = 0;
 		}
-
-#else
-		_gps_position->time_utc_usec = 0;
-#endif
 		_last_timestamp_time = gps_absolute_time();
 
 		// mavlink_log_info(&mavlink_log_pub, "get RMC data ");
@@ -740,9 +708,16 @@ int GPSDriverNMEA::receive(unsigned timeout)
 				int l = 0;
 
 				if ((l = parseChar(buf[j])) > 0) {
+					const gps_abstime complete_time = gps_absolute_time();
+					const int handled = handleMessage(l);
+
+					// sentence type without the talker id, e.g. "GGA"
+					reportMessage(_rx_buffer[3] << 16 | _rx_buffer[4] << 8 | _rx_buffer[5], _rx_start_time, complete_time,
+						      handled > 0 ? handled : 0);
+
 					/* return to configure during configuration or to the gps driver during normal work
 					 * if a packet has arrived */
-					if (handleMessage(l) > 0) {
+					if (handled > 0) {
 						return 1;
 					}
 				}
@@ -790,6 +765,7 @@ int GPSDriverNMEA::parseChar(uint8_t b)
             _decode_state = NMEA_DECODE_GOT_SYNC1;
 			_rx_buffer_bytes = 0;
 			_rx_buffer[_rx_buffer_bytes++] = b;
+			_rx_start_time = _read_time;
 		}
 
 		break;
@@ -798,6 +774,7 @@ int GPSDriverNMEA::parseChar(uint8_t b)
 		if (b == '$') {
             _decode_state = NMEA_DECODE_GOT_SYNC1;
 			_rx_buffer_bytes = 0;
+			_rx_start_time = _read_time;
 
 		} else if (b == '*') {
             _decode_state = NMEA_DECODE_GOT_NMEA;
@@ -851,5 +828,186 @@ void GPSDriverNMEA::decodeInit()
  		return -1;
   	}
 
-  			return setBaudrate(_baudrate);
-  	}
+	if (setBaudrate(_baudrate) != 0) {
+		return -1;
+	}
+
+	if (detectUblox()) {
+		configureUblox();
+	}
+
+	return 0;
+}
+
+int GPSDriverNMEA::sendSentence(const char *payload)
+{
+	char buf[64];
+	uint8_t checksum = 0;
+
+	for (const char *c = payload; *c != '\0'; c++) {
+		checksum ^= *c;
+	}
+
+	int len = snprintf(buf, sizeof(buf), "$%s*%02X\r\n", payload, checksum);
+
+	if (len <= 0 || len >= (int)sizeof(buf)) {
+		return -1;
+	}
+
+	return write(buf, len) == len ? 0 : -1;
+}
+
+bool GPSDriverNMEA::detectUblox()
+{
+	if (sendSentence("PUBX,00") != 0) {
+		return false;
+	}
+
+	uint8_t buf[GPS_READ_BUFFER_SIZE];
+	uint64_t time_started = gps_absolute_time();
+
+	while (time_started + NMEA_UBLOX_DETECT_TIMEOUT * 1000 > gps_absolute_time()) {
+		int ret = read(buf, sizeof(buf), NMEA_UBLOX_DETECT_TIMEOUT);
+
+		if (ret < 0) {
+			return false;
+		}
+
+		for (int i = 0; i < ret; i++) {
+			int len = parseChar(buf[i]);
+
+			// the sentence is only identified, the standard sentences received in between are dropped
+			if (len > 0 && memcmp(_rx_buffer, "$PUBX,00,", 9) == 0) {
+				decodeInit();
+				_decode_state = NMEA_DECODE_UNINIT;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void GPSDriverNMEA::configureUblox()
+{
+	/*
+	 * Output rate of each standard sentence, in navigation epochs (0: disabled).
+	 * GSV only updates the satellite info and is the longest message, so it is sent less often.
+	 */
+	static const struct {
+		const char *id;
+		uint8_t rate;
+	} sentences[] = {
+		{"GGA", 1},
+		{"GNS", 1},
+		{"GSA", 1},
+		{"GST", 1},
+		{"GSV", 5},
+		{"RMC", 1},
+		{"VTG", 1},
+		{"ZDA", 1},
+		{"DTM", 0},
+		{"GBS", 0},
+		{"GLL", 0},
+		{"GRS", 0},
+		{"VLW", 0},
+	};
+
+	char payload[40];
+
+	for (const auto &sentence : sentences) {
+		// same rate on all ports (I2C, UART1, UART2, USB, SPI), we don't know which one we're connected to
+		snprintf(payload, sizeof(payload), "PUBX,40,%s,%u,%u,%u,%u,%u,0", sentence.id, sentence.rate, sentence.rate,
+			 sentence.rate, sentence.rate, sentence.rate);
+		sendSentence(payload);
+	}
+
+	// highest rate for which the sentences fit into 80% of the serial bandwidth (10 bits per byte)
+	const unsigned max_rate = _baudrate / 10 * 8 / 10 / NMEA_UBLOX_EPOCH_BYTES;
+	unsigned rate = 1;
+
+	static const unsigned rates[] = {NMEA_UBLOX_MAX_RATE, 5, 2};
+
+	for (unsigned r : rates) {
+		if (r <= max_rate) {
+			rate = r;
+			break;
+		}
+	}
+
+	// UBX-CFG-RATE, there is no NMEA equivalent
+	struct {
+		uint8_t sync1;
+		uint8_t sync2;
+		uint16_t msg;
+		uint16_t length;
+		ubx_payload_tx_cfg_rate_t payload;
+		uint8_t ck_a;
+		uint8_t ck_b;
+	} __attribute__((packed)) cfg_rate {};
+
+	cfg_rate.sync1 = UBX_SYNC1;
+	cfg_rate.sync2 = UBX_SYNC2;
+	cfg_rate.msg = UBX_MSG_CFG_RATE;
+	cfg_rate.length = sizeof(cfg_rate.payload);
+	cfg_rate.payload.measRate = 1000 / rate;
+	cfg_rate.payload.navRate = UBX_TX_CFG_RATE_NAVRATE;
+	cfg_rate.payload.timeRef = UBX_TX_CFG_RATE_TIMEREF;
+
+	// checksum over class, id, length and payload
+	const uint8_t *data = (const uint8_t *)&cfg_rate.msg;
+
+	for (unsigned i = 0; i < sizeof(cfg_rate) - 4; i++) {
+		cfg_rate.ck_a += data[i];
+		cfg_rate.ck_b += cfg_rate.ck_a;
+	}
+
+	write(&cfg_rate, sizeof(cfg_rate));
+
+	if (waitForUbxAck(UBX_MSG_CFG_RATE)) {
+		GPS_INFO("NMEA: u-blox configured, %u Hz", rate);
+
+	} else {
+		GPS_WARN("NMEA: u-blox did not accept the %u Hz navigation rate", rate);
+	}
+}
+
+bool GPSDriverNMEA::waitForUbxAck(uint16_t msg)
+{
+	// sync, class, id, length (2), class & id of the acknowledged message, checksum
+	uint8_t ack[10] {};
+	uint8_t buf[GPS_READ_BUFFER_SIZE];
+	uint64_t time_started = gps_absolute_time();
+
+	while (time_started + NMEA_UBLOX_ACK_TIMEOUT * 1000 > gps_absolute_time()) {
+		int ret = read(buf, sizeof(buf), NMEA_UBLOX_ACK_TIMEOUT);
+
+		if (ret < 0) {
+			return false;
+		}
+
+		for (int i = 0; i < ret; i++) {
+			memmove(ack, ack + 1, sizeof(ack) - 1);
+			ack[sizeof(ack) - 1] = buf[i];
+
+			if (ack[0] != UBX_SYNC1 || ack[1] != UBX_SYNC2 || ack[2] != UBX_CLASS_ACK || ack[4] != 2 || ack[5] != 0
+			    || ack[6] != (msg & 0xFF) || ack[7] != (msg >> 8)) {
+				continue;
+			}
+
+			uint8_t ck_a = 0;
+			uint8_t ck_b = 0;
+
+			for (unsigned j = 2; j < 8; j++) {
+				ck_a += ack[j];
+				ck_b += ck_a;
+			}
+
+			if (ck_a == ack[8] && ck_b == ack[9]) {
+				return ack[3] == UBX_ID_ACK_ACK;
+			}
+		}
+	}
+
+	return false;
+}
@@ -43,6 +43,11 @@
 
 #define NMEA_RECV_BUFFER_SIZE 512
 
+#define NMEA_UBLOX_DETECT_TIMEOUT	500	///< wait time for the reply to the u-blox position poll [ms]
+#define NMEA_UBLOX_ACK_TIMEOUT		500	///< wait time for the ACK of a UBX configuration message [ms]
+#define NMEA_UBLOX_EPOCH_BYTES		450	///< approximate size of the configured sentences per epoch [bytes]
+#define NMEA_UBLOX_MAX_RATE		10	///< [Hz]
+
 class GPSDriverNMEA : public GPSHelper
 {
 public:
@@ -56,6 +61,28 @@ private:
     int handleMessage(int len);
     int parseChar(uint8_t b);
 
+    /**
+     * Check if the receiver is a u-blox, by polling the proprietary $PUBX,00 position sentence
+     * @return true if it replied
+     */
+    bool detectUblox();
+
+    /**
+     * Configure a u-blox receiver: output only the parsed sentences, at the highest navigation
+     * rate the baudrate allows
+     */
+    void configureUblox();
+
+    /**
+     * Wait for the UBX-ACK of a configuration message, the sentences received in between are dropped
+     * @param msg UBX class & id of the acknowledged message (UBX_MSG_*)
+     * @return true on ACK-ACK, false on ACK-NAK or timeout
+     */
+    bool waitForUbxAck(uint16_t msg);
+
+    /** send a sentence, the payload is given without '$' and checksum */
+    int sendSentence(const char *payload);
+
     int32_t read_int();
     double read_float();
     char read_char();
@@ -74,6 +101,7 @@ private:
     nmea_decode_state_t _decode_state{NMEA_DECODE_UNINIT};
     uint8_t _rx_buffer[NMEA_RECV_BUFFER_SIZE] {};
     uint16_t _rx_buffer_bytes{};
+    gps_abstime _rx_start_time{0}; /**< read time of the '$' of the sentence being received */
     bool _parse_error{}; /**< parse error flag */
     char *_parse_pos{}; /**< parse position */
     uint32_t _baudrate{9600};
@@ -779,6 +779,7 @@ GPSDriverUBX::parseChar(const uint8_t b)
 		if (b == UBX_SYNC1) {	// Sync1 found --> expecting Sync2
 			UBX_TRACE_PARSER("A");
 			_decode_state = UBX_DECODE_SYNC2;
+			_rx_start_time = _read_time;
 
 		} else if (b == RTCM3_PREAMBLE && _rtcm_parsing) {
 			UBX_TRACE_PARSER("RTCM");
@@ -896,7 +897,9 @@ GPSDriverUBX::parseChar(const uint8_t b)
 			UBX_DEBUG("ubx checksum err");
 
 		} else {
+			const gps_abstime complete_time = gps_absolute_time();
 			ret = payloadRxDone();	// finish payload processing
+			reportMessage(_rx_msg, _rx_start_time, complete_time, ret);
 		}
 
 		decodeInit();
@@ -1067,6 +1070,13 @@ GPSDriverUBX::payloadRxInit()
 
 		break;
 
+	case UBX_MSG_MGA_DBD:
+		if (_rx_payload_length > sizeof(ubx_payload_mga_dbd_t)) {
+			_rx_state = UBX_RXMSG_ERROR_LENGTH;
+		}
+
+		break;		// only sent on request, handle it even while configuring
+
 	case UBX_MSG_ACK_ACK:
 		if (_rx_payload_length != sizeof(ubx_payload_rx_ack_ack_t)) {
 			_rx_state = UBX_RXMSG_ERROR_LENGTH;
@@ -1644,6 +1654,12 @@ GPSDriverUBX::payloadRxDone()
 		ret = 1;
 		break;
 
+	case UBX_MSG_MGA_DBD:
+		UBX_TRACE_RXMSG("Rx MGA-DBD");
+
+		gotNavDatabase((uint8_t *)&_buf, _rx_payload_length);
+		break;
+
 	case UBX_MSG_ACK_ACK:
 		UBX_TRACE_RXMSG("Rx ACK-ACK");
 
@@ -1889,3 +1905,81 @@ GPSDriverUBX::reset(GPSRestartType restart_type)
 
 	return -2;
 }
+
+int
+GPSDriverUBX::aidReceiverState(const GPSReceiverState &state, uint64_t time_utc_usec)
+{
+	if (time_utc_usec > 0) {
+		time_t epoch = time_utc_usec / 1000000ULL;
+		struct tm timeinfo {};
+
+		if (gmtime_r(&epoch, &timeinfo) == nullptr) {
+			return -2;
+		}
+
+		memset(&_buf.payload_tx_mga_ini_time_utc, 0, sizeof(_buf.payload_tx_mga_ini_time_utc));
+		_buf.payload_tx_mga_ini_time_utc.type = UBX_TX_MGA_INI_TYPE_TIME_UTC;
+		_buf.payload_tx_mga_ini_time_utc.leapSecs = -128; // unknown
+		_buf.payload_tx_mga_ini_time_utc.year = timeinfo.tm_year + 1900;
+		_buf.payload_tx_mga_ini_time_utc.month = timeinfo.tm_mon + 1;
+		_buf.payload_tx_mga_ini_time_utc.day = timeinfo.tm_mday;
+		_buf.payload_tx_mga_ini_time_utc.hour = timeinfo.tm_hour;
+		_buf.payload_tx_mga_ini_time_utc.minute = timeinfo.tm_min;
+		_buf.payload_tx_mga_ini_time_utc.second = timeinfo.tm_sec;
+		_buf.payload_tx_mga_ini_time_utc.ns = (time_utc_usec % 1000000ULL) * 1000;
+		// the system clock is typically only synchronized to a few seconds
+		_buf.payload_tx_mga_ini_time_utc.tAccS = 10;
+
+		if (!sendMessage(UBX_MSG_MGA_INI, (uint8_t *)&_buf, sizeof(_buf.payload_tx_mga_ini_time_utc))) {
+			return -2;
+		}
+	}
+
+	if (state.lat == 0 && state.lon == 0) {
+		return 0;
+	}
+
+	memset(&_buf.payload_tx_mga_ini_pos_llh, 0, sizeof(_buf.payload_tx_mga_ini_pos_llh));
+	_buf.payload_tx_mga_ini_pos_llh.type = UBX_TX_MGA_INI_TYPE_POS_LLH;
+	_buf.payload_tx_mga_ini_pos_llh.lat = state.lat;
+	_buf.payload_tx_mga_ini_pos_llh.lon = state.lon;
+	_buf.payload_tx_mga_ini_pos_llh.alt = state.alt_ellipsoid / 10;
+	// the vehicle might have moved while the receiver was off: do not claim better than 100m
+	_buf.payload_tx_mga_ini_pos_llh.posAcc = state.pos_accuracy / 10 > 10000 ? state.pos_accuracy / 10 : 10000;
+
+	if (!sendMessage(UBX_MSG_MGA_INI, (uint8_t *)&_buf, sizeof(_buf.payload_tx_mga_ini_pos_llh))) {
+		return -2;
+	}
+
+	return 0;
+}
+
+int
+GPSDriverUBX::requestNavDatabase()
+{
+	// an empty MGA-DBD message polls the whole navigation database
+	if (!sendMessage(UBX_MSG_MGA_DBD, nullptr, 0)) {
+		return -2;
+	}
+
+	return 0;
+}
+
+int
+GPSDriverUBX::restoreNavDatabase(const uint8_t *data, int data_length)
+{
+	if (data_length <= 0 || data_length > (int)sizeof(_buf.payload_mga_dbd)) {
+		return -2;
+	}
+
+	memcpy(&_buf.payload_mga_dbd, data, data_length);
+
+	if (!sendMessage(UBX_MSG_MGA_DBD, (uint8_t *)&_buf, data_length)) {
+		return -2;
+	}
+
+	// the receiver has a limited input buffer, do not flood it
+	gps_usleep(2000);
+
+	return 0;
+}
@@ -62,6 +62,7 @@
 #define UBX_CLASS_ACK		0x05
 #define UBX_CLASS_CFG		0x06
 #define UBX_CLASS_MON		0x0A
+#define UBX_CLASS_MGA		0x13
 #define UBX_CLASS_RTCM3	0xF5
 
 /* Message IDs */
@@ -95,6 +96,8 @@
 #define UBX_ID_MON_VER		0x04
 #define UBX_ID_MON_HW		0x09 // deprecated in protocol version >= 27 -> use MON_RF
 #define UBX_ID_MON_RF		0x38
+#define UBX_ID_MGA_INI		0x40
+#define UBX_ID_MGA_DBD		0x80
 
 /* UBX ID for RTCM3 output messages */
 /* Minimal messages for RTK: 1005, 1077 + (1087 or 1127) */
@@ -143,6 +146,8 @@
 #define UBX_MSG_MON_HW		((UBX_CLASS_MON) | UBX_ID_MON_HW << 8)
 #define UBX_MSG_MON_VER		((UBX_CLASS_MON) | UBX_ID_MON_VER << 8)
 #define UBX_MSG_MON_RF		((UBX_CLASS_MON) | UBX_ID_MON_RF << 8)
+#define UBX_MSG_MGA_INI		((UBX_CLASS_MGA) | UBX_ID_MGA_INI << 8)
+#define UBX_MSG_MGA_DBD		((UBX_CLASS_MGA) | UBX_ID_MGA_DBD << 8)
 #define UBX_MSG_RTCM3_1005	((UBX_CLASS_RTCM3) | UBX_ID_RTCM3_1005 << 8)
 #define UBX_MSG_RTCM3_1077	((UBX_CLASS_RTCM3) | UBX_ID_RTCM3_1077 << 8)
 #define UBX_MSG_RTCM3_1087	((UBX_CLASS_RTCM3) | UBX_ID_RTCM3_1087 << 8)
@@ -692,6 +697,46 @@ typedef struct {
 	uint8_t     reserved3[8];
 } ubx_payload_tx_cfg_tmode3_t;
 
+/* Tx MGA-INI-POS_LLH */
+typedef struct {
+	uint8_t		type;		/**< Message type (0x01 for this type) */
+	uint8_t		version;	/**< Message version (0x00 for this version) */
+	uint8_t		reserved1[2];
+	int32_t		lat;		/**< Latitude [1e-7 deg] */
+	int32_t		lon;		/**< Longitude [1e-7 deg] */
+	int32_t		alt;		/**< Altitude above ellipsoid [cm] */
+	uint32_t	posAcc;		/**< Position accuracy (stddev) [cm] */
+} ubx_payload_tx_mga_ini_pos_llh_t;
+
+#define UBX_TX_MGA_INI_TYPE_POS_LLH	0x01
+
+/* Tx MGA-INI-TIME_UTC */
+typedef struct {
+	uint8_t		type;		/**< Message type (0x10 for this type) */
+	uint8_t		version;	/**< Message version (0x00 for this version) */
+	uint8_t		ref;		/**< Reference to be used to set time: 0 = on receipt of message */
+	int8_t		leapSecs;	/**< Number of leap seconds since 1980, -128 if unknown */
+	uint16_t	year;
+	uint8_t		month;		/**< range 1..12 */
+	uint8_t		day;		/**< range 1..31 */
+	uint8_t		hour;		/**< range 0..23 */
+	uint8_t		minute;		/**< range 0..59 */
+	uint8_t		second;		/**< range 0..60 */
+	uint8_t		reserved1;
+	uint32_t	ns;		/**< Nanoseconds, range 0..999,999,999 */
+	uint16_t	tAccS;		/**< Seconds part of time accuracy */
+	uint8_t		reserved2[2];
+	uint32_t	tAccNs;		/**< Nanoseconds part of time accuracy */
+} ubx_payload_tx_mga_ini_time_utc_t;
+
+#define UBX_TX_MGA_INI_TYPE_TIME_UTC	0x10
+
+/* Rx/Tx MGA-DBD (navigation database dump, transparently stored and sent back) */
+#define UBX_PAYLOAD_MGA_DBD_MAX_SIZE	176
+typedef struct {
+	uint8_t		data[UBX_PAYLOAD_MGA_DBD_MAX_SIZE];
+} ubx_payload_mga_dbd_t;
+
 /* General message and payload buffer union */
 typedef union {
 	ubx_payload_rx_nav_pvt_t		payload_rx_nav_pvt;
@@ -721,6 +766,9 @@ typedef union {
 	ubx_payload_tx_cfg_tmode3_t		payload_tx_cfg_tmode3;
 	ubx_payload_tx_cfg_cfg_t		payload_tx_cfg_cfg;
 	ubx_payload_tx_cfg_valset_t		payload_tx_cfg_valset;
+	ubx_payload_tx_mga_ini_pos_llh_t	payload_tx_mga_ini_pos_llh;
+	ubx_payload_tx_mga_ini_time_utc_t	payload_tx_mga_ini_time_utc;
+	ubx_payload_mga_dbd_t			payload_mga_dbd;
 } ubx_buf_t;
 
 #pragma pack(pop)
@@ -771,6 +819,9 @@ public:
 	int receive(unsigned timeout) override;
 	int configure(unsigned &baudrate, OutputMode output_mode) override;
 	int reset(GPSRestartType restart_type) override;
+	int aidReceiverState(const GPSReceiverState &state, uint64_t time_utc_usec) override;
+	int requestNavDatabase() override;
+	int restoreNavDatabase(const uint8_t *data, int data_length) override;
 
 private:
 
@@ -914,6 +965,7 @@ private:
 	bool			_got_velned{false};
 	ubx_decode_state_t	_decode_state{};
 	uint16_t		_rx_msg{};
+	gps_abstime		_rx_start_time{0};	///< read time of the first byte of the message being received
 	ubx_rxmsg_state_t	_rx_state{UBX_RXMSG_IGNORE};
 	uint16_t		_rx_payload_length{};
 	uint16_t		_rx_payload_index{};
@@ -52,9 +52,7 @@
 #include <px4_cli.h>
 #include <px4_getopt.h>
 #include <px4_module.h>
-#include <uORB/PublicationQueued.hpp>
 #include <uORB/Subscription.hpp>
-#include <uORB/topics/gps_dump.h>
 #include <uORB/topics/gps_inject_data.h>
 
 #include "devices/src/ashtech.h"
@@ -62,6 +60,10 @@
 #include "devices/src/mtk.h"
 #include "devices/src/ubx.h"
 #include "devices/src/nmea.h"
+#include "FakeTrajectory.hpp"
+#include "GPSDumpWriter.hpp"
+#include "GPSStateCacheWriter.hpp"
+#include "GPSStatistics.hpp"
 
 #ifdef __PX4_LINUX
 #include <linux/spi/spidev.h>
@@ -69,6 +71,11 @@
 
 #define TIMEOUT_5HZ 500
 #define RATE_MEASUREMENT_PERIOD 5000000
+#define STATE_CACHE_SAVE_PERIOD 30000000	///< [us] interval to persist the receiver state
+#define NAV_DB_REQUEST_PERIOD 600000000	///< [us] interval to request a navigation database dump
+#define NAV_DB_TIMEOUT 1000000			///< [us] the database dump is complete after this time without data
+#define CLOCK_CHECK_PERIOD 10000000		///< [us] interval to compare the system clock against the GPS time
+#define CLOCK_DRIFT_THRESHOLD 100000		///< [us] the system clock is only set if it is off by more than this
 
 typedef enum {
 	GPS_DRIVER_MODE_NONE = 0,
@@ -94,6 +101,8 @@ public:
 	enum class Instance : uint8_t {
 		Main = 0,
 		Secondary,
+		Tertiary,
+		Quaternary,
 
 		Count
 	};
@@ -120,7 +129,7 @@ public:
 	static int print_usage(const char *reason = nullptr);
 
 	/**
-	 * task spawn trampoline for the secondary GPS
+	 * task spawn trampoline for the secondary GPS instances
 	 */
 	static int run_trampoline_secondary(int argc, char *argv[]);
 
@@ -172,22 +181,30 @@ private:
 	unsigned			_last_rate_rtcm_injection_count{0}; 		///< counter for number of RTCM messages
 
 	const bool			_fake_gps;					///< fake gps output
+	FakeTrajectory			*_fake_trajectory{nullptr};			///< trajectory of the fake gps output
 
 	const Instance 			_instance;
 
 	uORB::Subscription		_orb_inject_data_sub{ORB_ID(gps_inject_data)};
-	uORB::PublicationQueued<gps_dump_s>	_dump_communication_pub{ORB_ID(gps_dump)};
-	gps_dump_s			*_dump_to_device{nullptr};
-	gps_dump_s			*_dump_from_device{nullptr};
-	bool				_should_dump_communication{false};			///< if true, dump communication
+	GPSDumpWriter			*_dump_writer{nullptr};				///< dumps the communication if enabled
+	GPSStatistics			_statistics;					///< latency statistics of the receive path
 
-	static volatile bool _is_gps_main_advertised; ///< for the second gps we want to make sure that it gets instance 1
-	/// and thus we wait until the first one publishes at least one message.
+	static volatile GPS *_secondary_instances[(int)Instance::Count]; ///< running secondary instances (index 0 is unused)
+	static volatile Instance _spawning_instance; ///< secondary instance that is currently being started
 
-	static volatile GPS *_secondary_instance;
+	unsigned			_num_published{0};				///< number of published position reports
 
 	volatile GPSRestartType _scheduled_reset{GPSRestartType::None};
 
+	bool				_state_cache_enabled{false};			///< if true, persist the receiver state for faster restarts
+	hrt_abstime			_last_state_save{0};
+	hrt_abstime			_fake_next_report{0};				///< scheduled time of the next fake report
+	hrt_abstime			_last_clock_check{0};				///< last time the system clock was compared to the GPS time
+	hrt_abstime			_last_nav_db_request{0};
+	hrt_abstime			_last_nav_db_data{0};
+	bool				_nav_db_receiving{false};			///< a navigation database dump is in progress
+	GPSStateCacheWriter		*_state_cache_writer{nullptr};			///< writes the state cache files
+
 	/**
 	 * Publish the gps struct
 	 */
@@ -198,6 +215,10 @@ private:
 	 */
 	void 				publishSatelliteInfo();
 
+	/**
+	 * Check if this instance may advertise its topics, so that the uORB instances are assigned in order
+	 */
+
 	/**
 	 * This is an abstraction for the poll on serial used.
 	 *
@@ -243,10 +264,32 @@ private:
 	void dumpGpsData(uint8_t *data, size_t len, bool msg_to_gps_device);
 
 	void initializeCommunicationDump();
+
+	/**
+	 * Periodically persist the receiver state and request a navigation database dump.
+	 * Called after each position update.
+	 */
+	void updateStateCache();
+
+	/**
+	 * Hand a navigation database chunk reported by the driver over to the state cache writer
+	 */
+	void storeNavDatabase(const uint8_t *data, int len);
+
+	/**
+	 * Set the system clock from the GPS time. The drivers report the time with every epoch, but the clock is only
+	 * compared every CLOCK_CHECK_PERIOD and only set if it is off by more than CLOCK_DRIFT_THRESHOLD.
+	 */
+	void setClock(const timespec &gps_time);
+
+	/**
+	 * Aid the freshly configured receiver with the cached state and navigation database
+	 */
+	void restoreStateCache();
 };
 
-volatile bool GPS::_is_gps_main_advertised = false;
-volatile GPS *GPS::_secondary_instance = nullptr;
+volatile GPS *GPS::_secondary_instances[(int)Instance::Count] {};
+volatile GPS::Instance GPS::_spawning_instance = GPS::Instance::Secondary;
 
 /*
  * Driver 'main' command.
@@ -278,36 +321,58 @@ GPS::GPS(const char *path, gps_driver_mode_t mode, GPSHelper::Interface interfac
 	}
 
 	_mode_auto = mode == GPS_DRIVER_MODE_NONE;
+
+	// Advertise right away, without data: the instances are constructed in index order, so each gets the uORB
+	// instance matching its index, whether the previous receivers are connected or not.
+	_report_gps_pos_pub = orb_advertise_multi(ORB_ID(vehicle_gps_position), nullptr, &_gps_orb_instance,
+			      ORB_PRIO_DEFAULT);
+
+	if (_p_report_sat_info) {
+		_report_sat_info_pub = orb_advertise_multi(ORB_ID(satellite_info), nullptr, &_gps_sat_orb_instance,
+				       ORB_PRIO_DEFAULT);
+	}
 }
 
 GPS::~GPS()
 {
-	GPS *secondary_instance = (GPS *) _secondary_instance;
+	if (_instance == Instance::Main) {
+		for (int instance = (int)Instance::Secondary; instance < (int)Instance::Count; ++instance) {
+			GPS *secondary_instance = (GPS *) _secondary_instances[instance];
 
-	if (_instance == Instance::Main && secondary_instance) {
-		secondary_instance->request_stop();
+			if (secondary_instance) {
+				secondary_instance->request_stop();
+			}
+		}
 
-		// wait for it to exit
-		unsigned int i = 0;
+		for (int instance = (int)Instance::Secondary; instance < (int)Instance::Count; ++instance) {
+			// wait for it to exit
+			unsigned int i = 0;
 
-		do {
-			px4_usleep(20000); // 20 ms
-			++i;
-		} while (_secondary_instance && i < 100);
+			while (_secondary_instances[instance] && i < 100) {
+				px4_usleep(20000); // 20 ms
+				++i;
+			}
+		}
 	}
 
 	if (_sat_info) {
 		delete (_sat_info);
 	}
 
-	if (_dump_to_device) {
-		delete (_dump_to_device);
+	if (_dump_writer) {
+		delete (_dump_writer);
 	}
 
-	if (_dump_from_device) {
-		delete (_dump_from_device);
+	if (_state_cache_writer) {
+		delete (_state_cache_writer);
 	}
 
+	if (_fake_trajectory) {
+		delete (_fake_trajectory);
+	}
+
+	orb_unadvertise(_report_gps_pos_pub);
+	orb_unadvertise(_report_sat_info_pub);
 }
 
 int GPS::callback(GPSCallbackType type, void *data1, int data2, void *user)
@@ -342,7 +407,15 @@ int GPS::callback(GPSCallbackType type, void *data1, int data2, void *user)
 		break;
 
 	case GPSCallbackType::setClock:
-		px4_clock_settime(CLOCK_REALTIME, (timespec *)data1);
+		gps->setClock(*(const timespec *)data1);
+		break;
+
+	case GPSCallbackType::gotNavDatabase:
+		gps->storeNavDatabase((const uint8_t *)data1, data2);
+		break;
+
+	case GPSCallbackType::gotMessage:
+		gps->_statistics.messageReceived(*(const GPSMessageTiming *)data1);
 		break;
 	}
 
@@ -371,6 +444,8 @@ int GPS::pollOrRead(uint8_t *buf, size_t buf_length, int timeout)
 
 	int ret = poll(fds, sizeof(fds) / sizeof(fds[0]), math::min(max_timeout, timeout));
 
+	_statistics.pollWakeup();
+
 	if (ret > 0) {
 		/* if we have new data from GPS, go handle it */
 		if (fds[0].revents & POLLIN) {
@@ -400,6 +475,10 @@ int GPS::pollOrRead(uint8_t *buf, size_t buf_length, int timeout)
 
 			ret = ::read(_serial_fd, buf, buf_length);
 
+			if (ret > 0) {
+				_statistics.readDone(ret);
+			}
+
 		} else {
 			ret = -1;
 		}
@@ -547,58 +626,152 @@ void GPS::initializeCommunicationDump()
 		return;
 	}
 
-	if (param_dump_comm != 1) {
+	const GPSDumpWriter::Mode mode = (GPSDumpWriter::Mode)param_dump_comm;
+
+	if (mode != GPSDumpWriter::Mode::Log && mode != GPSDumpWriter::Mode::File) {
 		return; //dumping disabled
 	}
 
-	_dump_from_device = new gps_dump_s();
-	_dump_to_device = new gps_dump_s();
+	_dump_writer = new GPSDumpWriter(mode, (int)_instance);
+
+	if (!_dump_writer || !_dump_writer->init()) {
+		PX4_ERR("failed to start dump writer");
+		delete _dump_writer;
+		_dump_writer = nullptr;
+	}
+}
 
-	if (!_dump_from_device || !_dump_to_device) {
-		PX4_ERR("failed to allocated dump data");
+void GPS::dumpGpsData(uint8_t *data, size_t len, bool msg_to_gps_device)
+{
+	if (_dump_writer) {
+		_dump_writer->append(data, len, msg_to_gps_device);
+	}
+}
+
+void GPS::updateStateCache()
+{
+	const hrt_abstime now = hrt_absolute_time();
+
+	// the navigation database dump is complete once the receiver stopped sending it
+	if (_nav_db_receiving && now - _last_nav_db_data > NAV_DB_TIMEOUT) {
+		_nav_db_receiving = false;
+		_state_cache_writer->finishNavDatabase();
+	}
+
+	if (_report_gps_pos.fix_type < 3 || _report_gps_pos.time_utc_usec == 0) {
 		return;
 	}
 
-	memset(_dump_to_device, 0, sizeof(gps_dump_s));
-	memset(_dump_from_device, 0, sizeof(gps_dump_s));
+	if (now - _last_state_save > STATE_CACHE_SAVE_PERIOD) {
+		_last_state_save = now;
 
-	//make sure to use a large enough queue size, so that we don't lose messages. You may also want
-	//to increase the logger rate for that.
-	_dump_communication_pub.publish(*_dump_from_device);
+		GPSReceiverState state{};
+		state.time_utc_usec = _report_gps_pos.time_utc_usec;
+		state.lat = _report_gps_pos.lat;
+		state.lon = _report_gps_pos.lon;
+		state.alt_ellipsoid = _report_gps_pos.alt_ellipsoid;
+		state.pos_accuracy = (uint32_t)(_report_gps_pos.eph * 1000.f);
 
-	_should_dump_communication = true;
+		_state_cache_writer->saveState(state);
+	}
+
+	// the database contains ephemerides, which are valid for a few hours
+	if (!_nav_db_receiving && (_last_nav_db_request == 0 || now - _last_nav_db_request > NAV_DB_REQUEST_PERIOD)) {
+		_last_nav_db_request = now;
+		_helper->requestNavDatabase();
+	}
 }
 
-void GPS::dumpGpsData(uint8_t *data, size_t len, bool msg_to_gps_device)
+void GPS::storeNavDatabase(const uint8_t *data, int len)
 {
-	if (!_should_dump_communication) {
+	if (!_state_cache_writer || len <= 0 || len > UINT16_MAX) {
 		return;
 	}
 
-	gps_dump_s *dump_data = msg_to_gps_device ? _dump_to_device : _dump_from_device;
+	_nav_db_receiving = true;
+	_last_nav_db_data = hrt_absolute_time();
+	_state_cache_writer->appendNavDatabase(data, (uint16_t)len);
+}
 
-	while (len > 0) {
-		size_t write_len = len;
+void GPS::setClock(const timespec &gps_time)
+{
+	const hrt_abstime now = hrt_absolute_time();
 
-		if (write_len > sizeof(dump_data->data) - dump_data->len) {
-			write_len = sizeof(dump_data->data) - dump_data->len;
-		}
+	if (_last_clock_check != 0 && now - _last_clock_check < CLOCK_CHECK_PERIOD) {
+		return;
+	}
+
+	_last_clock_check = now;
+
+	timespec ts{};
+	px4_clock_gettime(CLOCK_REALTIME, &ts);
 
-		memcpy(dump_data->data + dump_data->len, data, write_len);
-		data += write_len;
-		dump_data->len += write_len;
-		len -= write_len;
+	const int64_t drift = ((int64_t)ts.tv_sec - gps_time.tv_sec) * 1000000LL + (ts.tv_nsec - gps_time.tv_nsec) / 1000;
+
+	if (drift > CLOCK_DRIFT_THRESHOLD || drift < -CLOCK_DRIFT_THRESHOLD) {
+		timespec new_time = gps_time;
+		px4_clock_settime(CLOCK_REALTIME, &new_time);
+	}
+}
+
+void GPS::restoreStateCache()
+{
+	char path[64];
+	GPSStateCacheWriter::filePath(path, sizeof(path), (int)_instance, "state", false);
+	int fd = ::open(path, O_RDONLY);
 
-		if (dump_data->len >= sizeof(dump_data->data)) {
-			if (msg_to_gps_device) {
-				dump_data->len |= 1 << 7;
+	if (fd >= 0) {
+		GPSReceiverState state{};
+
+		if (::read(fd, &state, sizeof(state)) == sizeof(state)) {
+			timespec ts{};
+			px4_clock_gettime(CLOCK_REALTIME, &ts);
+			uint64_t time_utc_usec = 0;
+
+			// only use the system time if it has been set (e.g. by an RTC or a previous fix)
+			if (ts.tv_sec > GPS_EPOCH_SECS) {
+				time_utc_usec = (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
 			}
 
-			dump_data->timestamp = hrt_absolute_time();
-			_dump_communication_pub.publish(*dump_data);
-			dump_data->len = 0;
+			if (_helper->aidReceiverState(state, time_utc_usec) == 0) {
+				PX4_INFO("aiding receiver with cached state");
+			}
+		}
+
+		::close(fd);
+	}
+
+	GPSStateCacheWriter::filePath(path, sizeof(path), (int)_instance, "navdb", false);
+	fd = ::open(path, O_RDONLY);
+
+	if (fd < 0) {
+		return;
+	}
+
+	const int buf_length = 256;
+	uint8_t *buf = new uint8_t[buf_length];
+	uint16_t record_length;
+	int num_records = 0;
+
+	while (buf && ::read(fd, &record_length, sizeof(record_length)) == sizeof(record_length)
+	       && record_length <= buf_length && ::read(fd, buf, record_length) == record_length) {
+
+		if (_helper->restoreNavDatabase(buf, record_length) != 0) {
+			break;
 		}
+
+		++num_records;
 	}
+
+	delete[] buf;
+	::close(fd);
+
+	if (num_records > 0) {
+		PX4_INFO("restored %i navigation database records", num_records);
+	}
+
+	// the restored database is up to date, no need to dump it right away
+	_last_nav_db_request = hrt_absolute_time();
 }
 
 void
@@ -650,6 +823,32 @@ GPS::run()
 		param_get(handle, &gps_ubx_dynmodel);
 	}
 
+	int32_t gps_ash_bin = 0;
+	handle = param_find("GPS_ASH_BIN");
+
+	if (handle != PARAM_INVALID) {
+		param_get(handle, &gps_ash_bin);
+	}
+
+	int32_t gps_state_cache = 0;
+	handle = param_find("GPS_STATE_CACHE");
+
+	if (handle != PARAM_INVALID) {
+		param_get(handle, &gps_state_cache);
+	}
+
+	if (gps_state_cache == 1 && _state_cache_writer == nullptr) {
+		_state_cache_writer = new GPSStateCacheWriter((int)_instance);
+
+		if (_state_cache_writer == nullptr || !_state_cache_writer->init()) {
+			PX4_ERR("state cache init failed");
+			delete _state_cache_writer;
+			_state_cache_writer = nullptr;
+		}
+	}
+
+	_state_cache_enabled = _state_cache_writer != nullptr;
+
 	initializeCommunicationDump();
 
 	uint64_t last_rate_measurement = hrt_absolute_time();
@@ -659,34 +858,34 @@ GPS::run()
 	while (!should_exit()) {
 
 		if (_fake_gps) {
-			_report_gps_pos.timestamp = hrt_absolute_time();
-			_report_gps_pos.lat = (int32_t)47.378301e7f;
-			_report_gps_pos.lon = (int32_t)8.538777e7f;
-			_report_gps_pos.alt = (int32_t)1200e3f;
-			_report_gps_pos.alt_ellipsoid = 10000;
-			_report_gps_pos.s_variance_m_s = 0.5f;
-			_report_gps_pos.c_variance_rad = 0.1f;
-			_report_gps_pos.fix_type = 3;
-			_report_gps_pos.eph = 0.8f;
-			_report_gps_pos.epv = 1.2f;
-			_report_gps_pos.hdop = 0.9f;
-			_report_gps_pos.vdop = 0.9f;
-			_report_gps_pos.vel_n_m_s = 0.0f;
-			_report_gps_pos.vel_e_m_s = 0.0f;
-			_report_gps_pos.vel_d_m_s = 0.0f;
-			_report_gps_pos.vel_m_s = 0.0f;
-			_report_gps_pos.cog_rad = 0.0f;
-			_report_gps_pos.vel_ned_valid = true;
-			_report_gps_pos.satellites_used = 10;
-			_report_gps_pos.heading = NAN;
-			_report_gps_pos.heading_offset = NAN;
-
-			/* no time and satellite information simulated */
+			if (_fake_trajectory == nullptr) {
+				_fake_trajectory = new FakeTrajectory();
+
+				if (_fake_trajectory == nullptr) {
+					PX4_ERR("alloc failed");
+					break;
+				}
+
+				_fake_next_report = hrt_absolute_time();
+				_fake_trajectory->init(_fake_next_report);
+			}
+
+			// reports are computed and stamped for their scheduled time, which advances by exactly one
+			// interval, so that neither the rate nor the trajectory drift with the scheduling jitter
+			const hrt_abstime now = hrt_absolute_time();
 
+			if (now < _fake_next_report) {
+				px4_usleep(_fake_next_report - now);
 
+			} else if (now - _fake_next_report > _fake_trajectory->interval()) {
+				// more than one interval behind (e.g. the system was busy): skip the missed reports
+				_fake_next_report = now;
+			}
+
+			_fake_trajectory->update(_fake_next_report, _report_gps_pos);
 			publish();
 
-			px4_usleep(200000);
+			_fake_next_report += _fake_trajectory->interval();
 
 		} else {
 
@@ -710,7 +909,8 @@ GPS::run()
 				break;
 
 			case GPS_DRIVER_MODE_ASHTECH:
-				_helper = new GPSDriverAshtech(&GPS::callback, this, &_report_gps_pos, _p_report_sat_info, heading_offset);
+				_helper = new GPSDriverAshtech(&GPS::callback, this, &_report_gps_pos, _p_report_sat_info, heading_offset,
+								gps_ash_bin == 1);
 				break;
 
 			case GPS_DRIVER_MODE_EMLIDREACH:
@@ -747,6 +947,10 @@ GPS::run()
 					_helper->resetUpdateRates();
 				}
 
+				if (_state_cache_enabled) {
+					restoreStateCache();
+				}
+
 				int helper_ret;
 
 				while ((helper_ret = _helper->receive(TIMEOUT_5HZ)) > 0 && !should_exit()) {
@@ -755,6 +959,14 @@ GPS::run()
 						publish();
 
 						last_rate_count++;
+
+						if (_state_cache_enabled) {
+							updateStateCache();
+						}
+
+					} else if (helper_ret & 4) {
+						// heading of the last position, published with the unchanged position timestamp
+						publish();
 					}
 
 					if (_p_report_sat_info && (helper_ret & 2)) {
@@ -768,6 +980,7 @@ GPS::run()
 						float dt = (float)((hrt_absolute_time() - last_rate_measurement)) / 1000000.0f;
 						_rate = last_rate_count / dt;
 						_rate_rtcm_injection = _last_rate_rtcm_injection_count / dt;
+						_statistics.updateRates(dt);
 						last_rate_measurement = hrt_absolute_time();
 						last_rate_count = 0;
 						_last_rate_rtcm_injection_count = 0;
@@ -852,8 +1065,6 @@ GPS::run()
 		::close(_serial_fd);
 		_serial_fd = -1;
 	}
-
-	orb_unadvertise(_report_gps_pos_pub);
 }
 
 int
@@ -870,6 +1081,8 @@ GPS::print_status()
 		break;
 
 	default:
+		PX4_INFO("");
+		PX4_INFO("GPS %i", (int)_instance + 1);
 		break;
 	}
 
@@ -877,6 +1090,10 @@ GPS::print_status()
 	if (_fake_gps) {
 		PX4_INFO("protocol: SIMULATED");
 
+		if (_fake_trajectory) {
+			_fake_trajectory->print_status();
+		}
+
 	} else {
 		switch (_mode) {
 		case GPS_DRIVER_MODE_UBX:
@@ -906,6 +1123,15 @@ GPS::print_status()
 
 	PX4_INFO("status: %s, port: %s, baudrate: %d", _healthy ? "OK" : "NOT OK", _port, _baudrate);
 	PX4_INFO("sat info: %s", (_p_report_sat_info != nullptr) ? "enabled" : "disabled");
+	PX4_INFO("uORB instance: %i, publications: %u", _gps_orb_instance, _num_published);
+
+	if (_dump_writer) {
+		_dump_writer->print_status();
+	}
+
+	if (_state_cache_writer) {
+		_state_cache_writer->print_status();
+	}
 
 	if (_report_gps_pos.timestamp != 0) {
 		if (_helper) {
@@ -916,14 +1142,20 @@ GPS::print_status()
 		if (!_fake_gps) {
 			PX4_INFO("rate publication:\t\t%6.2f Hz", (double)_rate);
 			PX4_INFO("rate RTCM injection:\t%6.2f Hz", (double)_rate_rtcm_injection);
+			_statistics.print_status();
 		}
 
 		print_message(_report_gps_pos);
 	}
 
-	if (_instance == Instance::Main && _secondary_instance) {
-		GPS *secondary_instance = (GPS *)_secondary_instance;
-		secondary_instance->print_status();
+	if (_instance == Instance::Main) {
+		for (int instance = (int)Instance::Secondary; instance < (int)Instance::Count; ++instance) {
+			GPS *secondary_instance = (GPS *)_secondary_instances[instance];
+
+			if (secondary_instance) {
+				secondary_instance->print_status();
+			}
+		}
 	}
 
 	return 0;
@@ -934,9 +1166,14 @@ GPS::schedule_reset(GPSRestartType restart_type)
 {
 	_scheduled_reset = restart_type;
 
-	if (_instance == Instance::Main && _secondary_instance) {
-		GPS *secondary_instance = (GPS *)_secondary_instance;
-		secondary_instance->schedule_reset(restart_type);
+	if (_instance == Instance::Main) {
+		for (int instance = (int)Instance::Secondary; instance < (int)Instance::Count; ++instance) {
+			GPS *secondary_instance = (GPS *)_secondary_instances[instance];
+
+			if (secondary_instance) {
+				secondary_instance->schedule_reset(restart_type);
+			}
+		}
 	}
 }
 
@@ -964,31 +1201,21 @@ GPS::reset_if_scheduled()
 void
 GPS::publish()
 {
-	if (_instance == Instance::Main || _is_gps_main_advertised) {
-		orb_publish_auto(ORB_ID(vehicle_gps_position), &_report_gps_pos_pub, &_report_gps_pos, &_gps_orb_instance,
-				 ORB_PRIO_DEFAULT);
-		// Heading/yaw data can be updated at a lower rate than the other navigation data.
-		// The uORB message definition requires this data to be set to a NAN if no new valid data is available.
-		_report_gps_pos.heading = NAN;
-		_is_gps_main_advertised = true;
-	} else {
-		orb_publish_auto(ORB_ID(vehicle_gps_position), &_report_gps_pos_pub, &_report_gps_pos, &_gps_orb_instance,
-				 ORB_PRIO_DEFAULT);
-		_report_gps_pos.heading = NAN;
-		_is_gps_main_advertised = false;
-	}
+	orb_publish_auto(ORB_ID(vehicle_gps_position), &_report_gps_pos_pub, &_report_gps_pos, &_gps_orb_instance,
+			 ORB_PRIO_DEFAULT);
+	++_num_published;
+	_statistics.published();
+
+	// Heading/yaw data can be updated at a lower rate than the other navigation data.
+	// The uORB message definition requires this data to be set to a NAN if no new valid data is available.
+	_report_gps_pos.heading = NAN;
 }
 
 void
 GPS::publishSatelliteInfo()
 {
-	if (_instance == Instance::Main) {
-		orb_publish_auto(ORB_ID(satellite_info), &_report_sat_info_pub, _p_report_sat_info, &_gps_sat_orb_instance,
-				 ORB_PRIO_DEFAULT);
-
-	} else {
-		//we don't publish satellite info for the secondary gps
-	}
+	orb_publish_auto(ORB_ID(satellite_info), &_report_sat_info_pub, _p_report_sat_info, &_gps_sat_orb_instance,
+			 ORB_PRIO_DEFAULT);
 }
 
 int
@@ -1040,9 +1267,10 @@ int GPS::print_usage(const char *reason)
 GPS driver module that handles the communication with the device and publishes the position via uORB.
 It supports multiple protocols (device vendors) and by default automatically selects the correct one.
 
-The module supports a secondary GPS device, specified via `-e` parameter. The position will be published
-on the second uORB topic instance, but it's currently not used by the rest of the system (however the
-data will be logged, so that it can be used for comparisons).
+The module supports up to 3 secondary GPS devices, each specified via a `-e` parameter. The position of the
+N-th device will be published on the N-th uORB topic instance. Currently only the main instance is used by the
+rest of the system (however the data will be logged, so that it can be used for comparisons).
+The protocol of each device can be set with the GPS1_PROTOCOL ... GPS4_PROTOCOL parameters.
 
 ### Implementation
 There is a thread for each device polling for data. The GPS protocol classes are implemented with callbacks
@@ -1053,9 +1281,15 @@ For testing it can be useful to fake a GPS signal (it will signal the system tha
 $ gps stop
 $ gps start -f
 
+The fake GPS can also fly a circle, a line or a loop over the waypoints of a file (GPS_FAKE_MODE), at up to 50 Hz
+and with optional noise (see the GPS_FAKE_* parameters).
+
 Starting 2 GPS devices (the main GPS on /dev/ttyS3 and the secondary on /dev/ttyS4):
 $ gps start -d /dev/ttyS3 -e /dev/ttyS4
 
+Starting 3 GPS devices, the third one with a fixed baudrate:
+$ gps start -d /dev/ttyS3 -e /dev/ttyS4 -e /dev/ttyS1 -g 0 -g 115200
+
 Initiate warm restart of GPS device
 $ gps reset warm
 )DESCR_STR");
@@ -1064,8 +1298,8 @@ $ gps reset warm
 	PRINT_MODULE_USAGE_COMMAND("start");
 	PRINT_MODULE_USAGE_PARAM_STRING('d', "/dev/ttyS3", "<file:dev>", "GPS device", true);
 	PRINT_MODULE_USAGE_PARAM_INT('b', 0, 0, 3000000, "Baudrate (can also be p:<param_name>)", true);
-	PRINT_MODULE_USAGE_PARAM_STRING('e', "/dev/ttyS6", "<file:dev>", "Optional secondary GPS device", true);
-	PRINT_MODULE_USAGE_PARAM_INT('g', 0, 0, 3000000, "Baudrate (secondary GPS, can also be p:<param_name>)", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('e', "/dev/ttyS6", "<file:dev>", "Optional secondary GPS device (can be repeated)", true);
+	PRINT_MODULE_USAGE_PARAM_INT('g', 0, 0, 3000000, "Baudrate (secondary GPS, can also be p:<param_name>, can be repeated)", true);
 
 	PRINT_MODULE_USAGE_PARAM_FLAG('f', "Fake a GPS signal (useful for testing)", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('s', "Enable publication of satellite info", true);
@@ -1091,6 +1325,7 @@ int GPS::task_spawn(int argc, char *argv[], Instance instance)
 	if (instance == Instance::Main) {
 		entry_point = (px4_main_t)&run_trampoline;
 	} else {
+		_spawning_instance = instance;
 		entry_point = (px4_main_t)&run_trampoline_secondary;
 	}
 
@@ -1119,12 +1354,14 @@ int GPS::run_trampoline_secondary(int argc, char *argv[])
 	argv += 1;
 #endif
 
-	GPS *gps = instantiate(argc, argv, Instance::Secondary);
+	const Instance instance = _spawning_instance;
+
+	GPS *gps = instantiate(argc, argv, instance);
 	if (gps) {
-		_secondary_instance = gps;
+		_secondary_instances[(int)instance] = gps;
 		gps->run();
 
-		_secondary_instance = nullptr;
+		_secondary_instances[(int)instance] = nullptr;
 		delete gps;
 	}
 	return 0;
@@ -1137,9 +1374,11 @@ GPS *GPS::instantiate(int argc, char *argv[])
 GPS *GPS::instantiate(int argc, char *argv[], Instance instance)
 {
 	const char *device_name = "/dev/ttyS3";
-	const char *device_name_secondary = "/dev/ttyS6";
+	const char *device_name_secondary[(int)Instance::Count] = {nullptr, "/dev/ttyS6"};
+	int num_secondary = 0;
 	int baudrate_main = 0;
-	int baudrate_secondary = 0;
+	int baudrate_secondary[(int)Instance::Count] = {};
+	int num_baudrate_secondary = 0;
 	bool fake_gps = false;
 	bool enable_sat_info = false;
 	GPSHelper::Interface interface = GPSHelper::Interface::UART;
@@ -1159,7 +1398,11 @@ GPS *GPS::instantiate(int argc, char *argv[], Instance instance)
 			}
 			break;
 		case 'g':
-			if (px4_get_parameter_value(myoptarg, baudrate_secondary) != 0) {
+			if (num_baudrate_secondary >= (int)Instance::Count - 1) {
+				PX4_ERR("too many secondary baudrates");
+				error_flag = true;
+
+			} else if (px4_get_parameter_value(myoptarg, baudrate_secondary[++num_baudrate_secondary]) != 0) {
 				PX4_ERR("baudrate parsing failed");
 				error_flag = true;
 			}
@@ -1170,7 +1413,13 @@ GPS *GPS::instantiate(int argc, char *argv[], Instance instance)
 			break;
 
 		case 'e':
-			device_name_secondary = myoptarg;
+			if (num_secondary >= (int)Instance::Count - 1) {
+				PX4_ERR("too many secondary devices");
+				error_flag = true;
+
+			} else {
+				device_name_secondary[++num_secondary] = myoptarg;
+			}
 			break;
 
 		case 'f':
@@ -1231,86 +1480,72 @@ GPS *GPS::instantiate(int argc, char *argv[], Instance instance)
 		return nullptr;
 	}
 
-	GPS *gps;
-	if (instance == Instance::Main) {
+	// without -e, a single secondary device on the default port is used
+	if (num_secondary == 0) {
+		num_secondary = 1;
+	}
 
-		int32_t gps1_protocol_type = 0;
-                param_t gps1_type = param_find("GPS1_PROTOCOL");
-                if (gps1_type != PARAM_INVALID) {
-                param_get(gps1_type, &gps1_protocol_type);
-                }
-                switch (gps1_protocol_type)
-                {
-                case 0:// GPS_DRIVER_MODE_NONE
-                    mode = GPS_DRIVER_MODE_NONE;
-                    break;
-                case 1: //GPS_DRIVER_MODE_UBX
-                    mode = GPS_DRIVER_MODE_UBX;
-                    break;
-                case 2: //GPS_DRIVER_MODE_MTK
-                    mode = GPS_DRIVER_MODE_MTK;
-                    break;
-                case 3: //GPS_DRIVER_MODE_ASHTECH
-                    mode = GPS_DRIVER_MODE_ASHTECH;
-                    break;
-                case 4: //GPS_DRIVER_MODE_EMLIDREACH
-                    mode = GPS_DRIVER_MODE_EMLIDREACH;
-                    break;
-                case 5: //GPS_DRIVER_MODE_NMEA
-                    mode = GPS_DRIVER_MODE_NMEA;
-                    break;
-                default:
-                    break;
-                }
+	// the protocol of each instance is set via GPS<N>_PROTOCOL
+	int32_t gps_protocol_type = 0;
+	char param_name[17];
+	snprintf(param_name, sizeof(param_name), "GPS%i_PROTOCOL", (int)instance + 1);
+	param_t gps_type = param_find(param_name);
 
+	if (gps_type != PARAM_INVALID) {
+		param_get(gps_type, &gps_protocol_type);
+	}
+
+	switch (gps_protocol_type) {
+	case 0: // GPS_DRIVER_MODE_NONE
+		mode = GPS_DRIVER_MODE_NONE;
+		break;
+
+	case 1: // GPS_DRIVER_MODE_UBX
+		mode = GPS_DRIVER_MODE_UBX;
+		break;
+
+	case 2: // GPS_DRIVER_MODE_MTK
+		mode = GPS_DRIVER_MODE_MTK;
+		break;
+
+	case 3: // GPS_DRIVER_MODE_ASHTECH
+		mode = GPS_DRIVER_MODE_ASHTECH;
+		break;
+
+	case 4: // GPS_DRIVER_MODE_EMLIDREACH
+		mode = GPS_DRIVER_MODE_EMLIDREACH;
+		break;
+
+	case 5: // GPS_DRIVER_MODE_NMEA
+		mode = GPS_DRIVER_MODE_NMEA;
+		break;
+
+	default:
+		break;
+	}
+
+	GPS *gps;
+	if (instance == Instance::Main) {
 		gps = new GPS(device_name, mode, interface, fake_gps, enable_sat_info, instance, baudrate_main);
 
-		if (gps && device_name_secondary) {
-			task_spawn(argc, argv, Instance::Secondary);
+		for (int i = 1; gps && i <= num_secondary; ++i) {
+			task_spawn(argc, argv, (Instance)i);
 			// wait until running
-			int i = 0;
+			int j = 0;
 
 			do {
 				/* wait up to 1s */
 				px4_usleep(2500);
 
-			} while (!_secondary_instance && ++i < 400);
+			} while (!_secondary_instances[i] && ++j < 400);
 
-			if (i == 400) {
+			if (j == 400) {
 				PX4_ERR("Timed out while waiting for thread to start");
 			}
 		}
 	} else { // secondary instance
-		gps = new GPS(device_name_secondary, mode, interface, fake_gps, enable_sat_info, instance, baudrate_secondary);
-
-		int32_t gps2_protocol_type = 0;
-                param_t gps2_type = param_find("GPS2_PROTOCOL");
-                if (gps2_type != PARAM_INVALID) {
-                param_get(gps2_type, &gps2_protocol_type);
-                }
-                switch (gps2_protocol_type)
-                {
-                case 0:// GPS_DRIVER_MODE_NONE
-                    mode = GPS_DRIVER_MODE_NONE;
-                    break;
-                case 1: //GPS_DRIVER_MODE_UBX
-                    mode = GPS_DRIVER_MODE_UBX;
-                    break;
-                case 2: //GPS_DRIVER_MODE_MTK
-                    mode = GPS_DRIVER_MODE_MTK;
-                    break;
-                case 3: //GPS_DRIVER_MODE_ASHTECH
-                    mode = GPS_DRIVER_MODE_ASHTECH;
-                    break;
-                case 4: //GPS_DRIVER_MODE_EMLIDREACH
-                    mode = GPS_DRIVER_MODE_EMLIDREACH;
-                    break;
-                case 5: //GPS_DRIVER_MODE_NMEA
-                    mode = GPS_DRIVER_MODE_NMEA;
-                    break;
-                default:
-                    break;
-                }
+		gps = new GPS(device_name_secondary[(int)instance], mode, interface, fake_gps, enable_sat_info, instance,
+			      baudrate_secondary[(int)instance]);
 	}
 
 	return gps;
@@ -35,11 +35,18 @@
  * Dump GPS communication to a file.
  *
  * If this is set to 1, all GPS communication data will be published via uORB,
- * and written to the log file as gps_dump message.
+ * and written to the log file as gps_dump message. Each message is stamped with the
+ * time of its first byte and partial messages are flushed after 100 ms.
+ * This is meant for low data rates: the logger only gets a few messages per cycle
+ * (up to about 60 kB/s, less with a low logger rate), the rest is dropped.
+ * If this is set to 2, it is written to a separate file per GPS instance instead
+ * (gps1_dump.bin, ... in the storage directory), which is the mode to use for high data rates.
+ * The data is buffered and written at low priority, data that does not fit is dropped.
  * @min 0
- * @max 1
+ * @max 2
  * @value 0 Disable
- * @value 1 Enable
+ * @value 1 Enable (log)
+ * @value 2 Enable (file)
  * @group GPS
  */
 PARAM_DEFINE_INT32(GPS_DUMP_COMM, 0);
@@ -86,6 +93,20 @@ PARAM_DEFINE_INT32(GPS_UBX_DYNMODEL, 7);
  */
 PARAM_DEFINE_FLOAT(GPS_YAW_OFFSET, 0.f);
 
+/**
+ * Ashtech/Trimble binary position output
+ *
+ * If enabled, position and velocity are requested from Ashtech/Trimble receivers as binary
+ * PBN messages instead of $PASHR,POS text. This roughly halves the UART load, which is needed for
+ * 20 Hz output with dual antenna heading at 115200 baud.
+ *
+ * @boolean
+ * @reboot_required true
+ *
+ * @group GPS
+ */
+PARAM_DEFINE_INT32(GPS_ASH_BIN, 0);
+
 /**
  * nmea GPS baudrate
  *
@@ -137,3 +158,149 @@ PARAM_DEFINE_INT32(GPS1_PROTOCOL, 0);
 * @group GPS
 */
 PARAM_DEFINE_INT32(GPS2_PROTOCOL, 0);
+
+/**
+* GPS3 ptotocol type
+*
+*This parameter is used to set if use manual gps mode or auto gps mode
+*
+* @min 0
+* @max 5
+* @value 0 set gps mode to GPS_DRIVER_MODE_NONE
+* @value 1 set gps mode to GPS_DRIVER_MODE_UBX
+* @value 2 set gps mode to GPS_DRIVER_MODE_MTK
+* @value 3 set gps mode to GPS_DRIVER_MODE_ASHTECH
+* @value 4 set gps mode to GPS_DRIVER_MODE_EMLIDREACH
+* @value 5 set gps mode to GPS_DRIVER_MODE_NMEA
+* @reboot_required true
+*
+* @group GPS
+*/
+PARAM_DEFINE_INT32(GPS3_PROTOCOL, 0);
+
+/**
+* GPS4 ptotocol type
+*
+*This parameter is used to set if use manual gps mode or auto gps mode
+*
+* @min 0
+* @max 5
+* @value 0 set gps mode to GPS_DRIVER_MODE_NONE
+* @value 1 set gps mode to GPS_DRIVER_MODE_UBX
+* @value 2 set gps mode to GPS_DRIVER_MODE_MTK
+* @value 3 set gps mode to GPS_DRIVER_MODE_ASHTECH
+* @value 4 set gps mode to GPS_DRIVER_MODE_EMLIDREACH
+* @value 5 set gps mode to GPS_DRIVER_MODE_NMEA
+* @reboot_required true
+*
+* @group GPS
+*/
+PARAM_DEFINE_INT32(GPS4_PROTOCOL, 0);
+
+/**
+ * Cache the receiver state for faster restarts
+ *
+ * If enabled, the last position and the navigation database of the receiver are periodically stored
+ * on the SD card and sent back to the receiver after it has been (re)configured.
+ * This reduces the time to first fix after a power cycle, e.g. after a battery swap in the field.
+ *
+ * Currently only supported by u-blox receivers (MGA-INI position/time aiding and MGA-DBD).
+ *
+ * @boolean
+ * @reboot_required true
+ *
+ * @group GPS
+ */
+PARAM_DEFINE_INT32(GPS_STATE_CACHE, 0);
+
+/**
+ * Fake GPS trajectory
+ *
+ * Trajectory of the fake GPS output (gps start -f). The circle is centered at the reference
+ * position, the line starts there and goes back and forth. The waypoint loop is read from
+ * gps_fake_wp.txt in the storage directory, with one "lat lon alt" line per waypoint
+ * (degrees, degrees, meters AMSL); the first waypoint is the reference.
+ *
+ * @value 0 Fixed position
+ * @value 1 Circle
+ * @value 2 Line
+ * @value 3 Waypoint loop
+ * @reboot_required true
+ *
+ * @group GPS
+ */
+PARAM_DEFINE_INT32(GPS_FAKE_MODE, 0);
+
+/**
+ * Fake GPS output rate
+ *
+ * @min 1
+ * @max 50
+ * @unit Hz
+ * @reboot_required true
+ *
+ * @group GPS
+ */
+PARAM_DEFINE_INT32(GPS_FAKE_RATE, 5);
+
+/**
+ * Fake GPS ground speed
+ *
+ * Speed along the fake GPS trajectory.
+ *
+ * @min 0
+ * @max 100
+ * @unit m/s
+ * @decimal 1
+ * @reboot_required true
+ *
+ * @group GPS
+ */
+PARAM_DEFINE_FLOAT(GPS_FAKE_SPEED, 5.f);
+
+/**
+ * Fake GPS trajectory size
+ *
+ * Radius of the circle or length of the line.
+ *
+ * @min 1
+ * @max 10000
+ * @unit m
+ * @decimal 0
+ * @reboot_required true
+ *
+ * @group GPS
+ */
+PARAM_DEFINE_FLOAT(GPS_FAKE_DIST, 50.f);
+
+/**
+ * Fake GPS line direction
+ *
+ * Direction of the line, clockwise from north.
+ *
+ * @min 0
+ * @max 360
+ * @unit deg
+ * @decimal 0
+ * @reboot_required true
+ *
+ * @group GPS
+ */
+PARAM_DEFINE_FLOAT(GPS_FAKE_HDG, 0.f);
+
+/**
+ * Fake GPS position noise
+ *
+ * Standard deviation of the horizontal position noise (1.5 times this vertically). The position
+ * noise is correlated over about 10 s, like the error of a real receiver; the velocity gets a tenth
+ * of it as white noise. Set to 0 to disable.
+ *
+ * @min 0
+ * @max 20
+ * @unit m
+ * @decimal 1
+ * @reboot_required true
+ *
+ * @group GPS
+ */
+PARAM_DEFINE_FLOAT(GPS_FAKE_NOISE, 0.f);
@@ -0,0 +1,847 @@
+#!/usr/bin/env python3
+############################################################################
+#
+#   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+"""
+GPS receiver emulator on a pseudo-terminal (Linux), to run the gps driver end to end without hardware.
+
+The emulated receiver answers the configuration sequence of the driver (ACKs, version and port queries),
+follows the baudrate changes it requests and then streams synthetic epochs of a vehicle flying a circle,
+or replays a communication dump (GPS_DUMP_COMM = 2). The serial bandwidth is emulated: output is paced
+at the current baudrate and nothing gets through while the driver and the receiver use different baudrates.
+
+Supported protocols: ubx (u-blox 8 or 9), nmea (optionally answering the u-blox proprietary sentences),
+ashtech (NMEA or PBN binary output with GPS_ASH_BIN, dual antenna heading as a Trimble MB-Two) and
+erb (Emlid Reach, optionally with an RTK solution).
+
+Example, with the driver running in SITL:
+    ./gps_emulator.py --protocol ubx --link /tmp/ttyGPS
+    pxh> gps start -d /tmp/ttyGPS -p ubx
+    pxh> gps status
+
+The statistics printed every few seconds show the configuration time, the link load and the epochs that
+were dropped because they did not fit into the serial bandwidth. Increase --rate until epochs are dropped
+to find the maximum sustainable navigation rate for a baudrate, and compare with the driver's status.
+"""
+
+import argparse
+import math
+import os
+import select
+import struct
+import sys
+import termios
+import time
+import tty
+
+BAUDRATES = {
+    termios.B4800: 4800,
+    termios.B9600: 9600,
+    termios.B19200: 19200,
+    termios.B38400: 38400,
+    termios.B57600: 57600,
+    termios.B115200: 115200,
+    termios.B230400: 230400,
+    termios.B460800: 460800,
+    termios.B921600: 921600,
+}
+
+GPS_EPOCH_OFFSET = 315964800  # 1970-01-01 to 1980-01-06 [s]
+GPS_LEAP_SECONDS = 18
+KNOTS = 1.9438445  # [kn / (m/s)]
+WGS84_A = 6378137.0  # semi-major axis [m]
+WGS84_E2 = 6.69437999014e-3  # first eccentricity squared
+
+# satellites in view: prn, elevation [deg], azimuth [deg], C/N0 [dB-Hz]
+SATELLITES = [(1, 45, 83, 46), (3, 62, 270, 48), (6, 12, 310, 39), (9, 33, 150, 42)]
+
+
+class Link:
+    """ Pseudo-terminal with the timing of a serial link at a given baudrate """
+
+    def __init__(self, baudrate, link_path=None):
+        self.master, self.slave = os.openpty()
+        # no echo and no line processing until the driver configures the port
+        tty.setraw(self.slave)
+        os.set_blocking(self.master, False)
+        self.path = os.ttyname(self.slave)
+        self.link_path = link_path
+
+        if link_path:
+            if os.path.islink(link_path):
+                os.unlink(link_path)
+
+            os.symlink(self.path, link_path)
+
+        self.baudrate = baudrate
+        self._tx = bytearray()
+        self._budget = 0.0
+        self._last_service = time.monotonic()
+
+        self.tx_bytes = 0
+        self.tx_lost = 0  # sent while the baudrates did not match
+        self.rx_bytes = 0
+        self.rx_lost = 0
+
+    def close(self):
+        if self.link_path and os.path.islink(self.link_path):
+            os.unlink(self.link_path)
+
+        os.close(self.master)
+        os.close(self.slave)
+
+    def peer_baudrate(self):
+        """ baudrate the driver has configured on its side """
+        return BAUDRATES.get(termios.tcgetattr(self.slave)[5], 0)
+
+    def in_sync(self):
+        return self.peer_baudrate() == self.baudrate
+
+    def byte_time(self):
+        """ time to transmit 1 byte, 8N1 [s] """
+        return 10.0 / self.baudrate
+
+    def read(self):
+        try:
+            data = os.read(self.master, 4096)
+
+        except (BlockingIOError, OSError):
+            return b''
+
+        if not self.in_sync():
+            self.rx_lost += len(data)
+            return b''
+
+        self.rx_bytes += len(data)
+        return data
+
+    def send(self, data):
+        self._tx += data
+
+    def pending(self):
+        return len(self._tx)
+
+    def service(self):
+        """ write as much as the serial bandwidth allows since the last call """
+        now = time.monotonic()
+        burst = max(64.0, 0.005 / self.byte_time())  # like a small UART FIFO
+        self._budget = min(self._budget + (now - self._last_service) / self.byte_time(), burst)
+        self._last_service = now
+
+        count = min(int(self._budget), len(self._tx))
+
+        if count == 0:
+            return
+
+        if self.in_sync():
+            try:
+                written = os.write(self.master, bytes(self._tx[:count]))
+
+            except (BlockingIOError, OSError):
+                written = 0
+
+        else:
+            written = count
+            self.tx_lost += count
+
+        del self._tx[:written]
+        self._budget -= written
+        self.tx_bytes += written
+
+
+class Trajectory:
+    """ Circle around a reference point, or a fixed position if the radius is 0 """
+
+    def __init__(self, lat, lon, alt, radius, speed):
+        self.lat0 = math.radians(lat)
+        self.lon0 = math.radians(lon)
+        self.alt0 = alt
+        self.radius = radius
+        self.speed = speed
+
+    def state(self, t):
+        """ @return lat [deg], lon [deg], alt [m], vel_n, vel_e, vel_d [m/s] """
+        if self.radius <= 0:
+            return math.degrees(self.lat0), math.degrees(self.lon0), self.alt0, 0.0, 0.0, 0.0
+
+        omega = self.speed / self.radius
+        angle = omega * t
+        north = self.radius * math.cos(angle)
+        east = self.radius * math.sin(angle)
+        earth_radius = 6371000.0
+        lat = self.lat0 + north / earth_radius
+        lon = self.lon0 + east / (earth_radius * math.cos(self.lat0))
+        return (math.degrees(lat), math.degrees(lon), self.alt0,
+                -self.speed * math.sin(angle), self.speed * math.cos(angle), 0.0)
+
+
+def gps_time(utc):
+    """ @return GPS week, time of week [ms] """
+    seconds = utc - GPS_EPOCH_OFFSET + GPS_LEAP_SECONDS
+    week = int(seconds // 604800)
+    return week, int(round((seconds - week * 604800) * 1000))
+
+
+def ecef(lat, lon, alt, vel_n, vel_e, vel_d):
+    """ @return ECEF position [m] and velocity [m/s] of a WGS84 position and NED velocity """
+    lat, lon = math.radians(lat), math.radians(lon)
+    sin_lat, cos_lat = math.sin(lat), math.cos(lat)
+    sin_lon, cos_lon = math.sin(lon), math.cos(lon)
+    n = WGS84_A / math.sqrt(1 - WGS84_E2 * sin_lat * sin_lat)
+    position = ((n + alt) * cos_lat * cos_lon, (n + alt) * cos_lat * sin_lon, (n * (1 - WGS84_E2) + alt) * sin_lat)
+    velocity = (-sin_lat * cos_lon * vel_n - sin_lon * vel_e - cos_lat * cos_lon * vel_d,
+                -sin_lat * sin_lon * vel_n + cos_lon * vel_e - cos_lat * sin_lon * vel_d,
+                cos_lat * vel_n - sin_lat * vel_d)
+    return position, velocity
+
+
+def split_messages(buf):
+    """
+    Extract the complete UBX frames and NMEA-like sentences from a receive buffer, the other bytes
+    (e.g. RTCM corrections) are skipped.
+    @return list of ('ubx', cls, id, payload) or ('nmea', sentence without checksum), remaining bytes
+    """
+    messages = []
+
+    while True:
+        ubx = buf.find(b'\xb5\x62')
+        nmea = buf.find(b'$')
+
+        if ubx < 0 and nmea < 0:
+            return messages, b''
+
+        if ubx >= 0 and (nmea < 0 or ubx < nmea):
+            buf = buf[ubx:]
+
+            if len(buf) < 6:
+                return messages, buf
+
+            length = struct.unpack_from('<H', buf, 4)[0]
+
+            if len(buf) < 8 + length:
+                return messages, buf
+
+            if fletcher(buf[2:6 + length]) == buf[6 + length:8 + length]:
+                messages.append(('ubx', buf[2], buf[3], buf[6:6 + length]))
+                buf = buf[8 + length:]
+
+            else:
+                buf = buf[2:]
+
+        else:
+            buf = buf[nmea:]
+            end = buf.find(b'\n')
+
+            if end < 0:
+                # drop a sentence that can never complete
+                return messages, buf if len(buf) < 256 else b''
+
+            sentence = buf[1:end].decode('ascii', 'replace').strip()
+            messages.append(('nmea', sentence.split('*')[0]))
+            buf = buf[end + 1:]
+
+
+def fletcher(data):
+    ck_a = ck_b = 0
+
+    for b in data:
+        ck_a = (ck_a + b) & 0xFF
+        ck_b = (ck_b + ck_a) & 0xFF
+
+    return bytes([ck_a, ck_b])
+
+
+def nmea_sentence(payload):
+    checksum = 0
+
+    for c in payload.encode('ascii'):
+        checksum ^= c
+
+    return ('$%s*%02X\r\n' % (payload, checksum)).encode('ascii')
+
+
+def nmea_lat_lon(lat, lon):
+    """ @return ddmm.mmmmm,N,dddmm.mmmmm,E """
+    lat_abs, lon_abs = abs(lat), abs(lon)
+    return '%02d%08.5f,%s,%03d%08.5f,%s' % (int(lat_abs), (lat_abs - int(lat_abs)) * 60, 'N' if lat >= 0 else 'S',
+                                          int(lon_abs), (lon_abs - int(lon_abs)) * 60, 'E' if lon >= 0 else 'W')
+
+
+def nmea_time(utc):
+    return time.strftime('%H%M%S', time.gmtime(utc)) + ('%.2f' % (utc % 1))[1:]
+
+
+class Receiver:
+    """ Base class of the emulated receivers """
+
+    default_baudrate = 9600
+
+    def __init__(self, link, rate):
+        self.link = link
+        self.rate = rate  # navigation rate [Hz], as configured by the driver
+        self.rate_override = None  # from the command line, ignores the configuration
+        self.streaming = False  # epochs are only sent once this is set
+        self.config_time = None  # last configuration command [s since start]
+        self._pending_baudrate = None
+        self._rx = b''
+
+    def nav_rate(self):
+        return self.rate_override or self.rate
+
+    def handle_input(self, data, now):
+        messages, self._rx = split_messages(self._rx + data)
+
+        for message in messages:
+            if self.handle_message(message):
+                self.config_time = now
+
+    def handle_message(self, message):
+        """ @return True if this was a configuration command """
+        return False
+
+    def change_baudrate(self, baudrate):
+        """ switch once the pending output (e.g. the ACK) is sent """
+        self._pending_baudrate = baudrate
+
+    def update(self):
+        if self._pending_baudrate and self.link.pending() == 0:
+            self.link.baudrate = self._pending_baudrate
+            self._pending_baudrate = None
+
+    def epoch(self, utc, state, index):
+        """ @return the messages of an epoch """
+        return b''
+
+
+class UbxReceiver(Receiver):
+    """ u-blox 8 (protocol 18, CFG-PRT/CFG-MSG) or 9 (protocol 27, CFG-VALSET) """
+
+    default_baudrate = 9600
+
+    MSG_NAV_PVT = (0x01, 0x07)
+    MSG_NAV_DOP = (0x01, 0x04)
+
+    # CFG-MSGOUT keys of the first port (I2C), the other ports follow (UART1, UART2, USB, SPI)
+    MSGOUT_KEYS = {0x20910006: MSG_NAV_PVT, 0x20910038: MSG_NAV_DOP}
+    KEY_UART1_BAUDRATE = 0x40520001
+    KEY_RATE_MEAS = 0x30210001
+
+    def __init__(self, link, rate, generation):
+        super().__init__(link, rate)
+        self.generation = generation
+        self.msg_rates = {}
+
+    def send(self, cls, msg_id, payload):
+        self.link.send(b'\xb5\x62' + self.frame_body(cls, msg_id, payload))
+
+    @staticmethod
+    def frame_body(cls, msg_id, payload):
+        body = struct.pack('<BBH', cls, msg_id, len(payload)) + payload
+        return body + fletcher(body)
+
+    def ack(self, cls, msg_id, ok=True):
+        self.send(0x05, 0x01 if ok else 0x00, bytes([cls, msg_id]))
+
+    def handle_message(self, message):
+        if message[0] != 'ubx':
+            return False
+
+        _, cls, msg_id, payload = message
+
+        if (cls, msg_id) == (0x0A, 0x04) and len(payload) == 0:  # MON-VER poll
+            hw_version = b'00190000' if self.generation == 9 else b'00080000'
+            protocol = b'PROTVER=27.11' if self.generation == 9 else b'PROTVER=18.00'
+            self.send(0x0A, 0x04, b'ROM CORE 3.01 (107888)'.ljust(30, b'\0') + hw_version.ljust(10, b'\0') +
+                      protocol.ljust(30, b'\0'))
+            return True
+
+        if cls != 0x06:
+            return False
+
+        if msg_id == 0x8A:  # CFG-VALSET
+            if self.generation < 9:
+                self.ack(cls, msg_id, False)
+                return True
+
+            self.ack(cls, msg_id)
+            self.handle_valset(payload[4:])
+
+        elif msg_id == 0x00 and len(payload) >= 20:  # CFG-PRT
+            self.ack(cls, msg_id)
+            baudrate = struct.unpack_from('<I', payload, 8)[0]
+
+            if baudrate and baudrate != self.link.baudrate:
+                self.change_baudrate(baudrate)
+
+        elif msg_id == 0x08 and len(payload) >= 2:  # CFG-RATE
+            self.ack(cls, msg_id)
+            self.rate = 1000.0 / max(struct.unpack_from('<H', payload)[0], 1)
+
+        elif msg_id == 0x01 and len(payload) >= 3:  # CFG-MSG
+            self.ack(cls, msg_id)
+            # 3 bytes: rate on the current port, 8 bytes: rate per port (UART1 is the second)
+            self.set_msg_rate((payload[0], payload[1]), payload[2] if len(payload) == 3 else payload[3])
+
+        else:
+            self.ack(cls, msg_id)
+
+        return True
+
+    def handle_valset(self, data):
+        sizes = {1: 1, 2: 1, 3: 2, 4: 4, 5: 8}
+        pos = 0
+
+        while pos + 4 <= len(data):
+            key = struct.unpack_from('<I', data, pos)[0]
+            size = sizes.get((key >> 28) & 0x7, 1)
+            value = int.from_bytes(data[pos + 4:pos + 4 + size], 'little')
+            pos += 4 + size
+
+            if key == self.KEY_UART1_BAUDRATE:
+                self.change_baudrate(value)
+
+            elif key == self.KEY_RATE_MEAS:
+                self.rate = 1000.0 / max(value, 1)
+
+            else:
+                for base, msg in self.MSGOUT_KEYS.items():
+                    if base <= key < base + 5:
+                        self.set_msg_rate(msg, value)
+
+    def set_msg_rate(self, msg, rate):
+        self.msg_rates[msg] = rate
+        self.streaming = any(self.msg_rates.values())
+
+    def epoch(self, utc, state, index):
+        lat, lon, alt, vel_n, vel_e, vel_d = state
+        week, itow = gps_time(utc)
+        t = time.gmtime(utc)
+        out = b''
+
+        if self.due(self.MSG_NAV_PVT, index):
+            ground_speed = math.hypot(vel_n, vel_e)
+            heading = math.degrees(math.atan2(vel_e, vel_n)) % 360
+            payload = struct.pack('<IHBBBBBBIiBBBBiiiiIIiiiiiIIHHIiI', itow, t.tm_year, t.tm_mon, t.tm_mday,
+                                  t.tm_hour, t.tm_min, t.tm_sec, 0x07, 30, int((utc % 1) * 1e9), 3, 0x01, 0,
+                                  14, int(round(lon * 1e7)), int(round(lat * 1e7)), int(alt * 1000),
+                                  int((alt - 47.0) * 1000), 800, 1200, int(vel_n * 1000), int(vel_e * 1000),
+                                  int(vel_d * 1000), int(ground_speed * 1000), int(heading * 1e5), 150,
+                                  int(0.5e5), 120, 0, 0, int(heading * 1e5), 0)
+            out += b'\xb5\x62' + self.frame_body(0x01, 0x07, payload)
+
+        if self.due(self.MSG_NAV_DOP, index):
+            payload = struct.pack('<IHHHHHHH', itow, 150, 120, 90, 100, 80, 60, 50)
+            out += b'\xb5\x62' + self.frame_body(0x01, 0x04, payload)
+
+        return out
+
+    def due(self, msg, index):
+        rate = self.msg_rates.get(msg, 0)
+        return rate > 0 and index % rate == 0
+
+
+class NmeaReceiver(Receiver):
+    """ Standard NMEA output, optionally a u-blox answering $PUBX,00 and taking $PUBX,40 and UBX-CFG-RATE """
+
+    default_baudrate = 9600
+
+    def __init__(self, link, rate, ublox):
+        super().__init__(link, rate)
+        self.ublox = ublox
+        self.streaming = True
+        self.sentence_rates = {'GGA': 1, 'GSA': 1, 'RMC': 1, 'VTG': 1, 'ZDA': 1, 'GST': 1, 'GSV': 5}
+        self._last_state = None
+
+    def handle_message(self, message):
+        if not self.ublox:
+            return False
+
+        if message[0] == 'ubx':
+            _, cls, msg_id, payload = message
+
+            if (cls, msg_id) == (0x06, 0x08) and len(payload) >= 2:  # CFG-RATE
+                self.rate = 1000.0 / max(struct.unpack_from('<H', payload)[0], 1)
+                self.link.send(b'\xb5\x62' + UbxReceiver.frame_body(0x05, 0x01, bytes([cls, msg_id])))
+                return True
+
+            return False
+
+        fields = message[1].split(',')
+
+        if fields[:2] == ['PUBX', '00'] and len(fields) == 2 and self._last_state:
+            utc, (lat, lon, alt, vel_n, vel_e, vel_d) = self._last_state
+            self.link.send(nmea_sentence('PUBX,00,%s,%s,%.3f,G3,0.8,1.2,%.3f,%.2f,%.3f,,0.92,1.19,0.77,14,0,0' %
+                                         (nmea_time(utc), nmea_lat_lon(lat, lon), alt,
+                                          math.hypot(vel_n, vel_e) * 3.6,
+                                          math.degrees(math.atan2(vel_e, vel_n)) % 360, -vel_d)))
+            return True
+
+        if fields[:2] == ['PUBX', '40'] and len(fields) >= 5:
+            self.sentence_rates[fields[2]] = int(fields[4] or 0)  # UART1
+            return True
+
+        return False
+
+    def epoch(self, utc, state, index):
+        self._last_state = (utc, state)
+        lat, lon, alt, vel_n, vel_e, vel_d = state
+        ground_speed = math.hypot(vel_n, vel_e)
+        course = math.degrees(math.atan2(vel_e, vel_n)) % 360
+        hms = nmea_time(utc)
+        position = nmea_lat_lon(lat, lon)
+        sentences = {
+            'GGA': 'GNGGA,%s,%s,1,14,0.8,%.3f,M,47.0,M,,' % (hms, position, alt - 47.0),
+            'GSA': 'GNGSA,A,3,01,03,06,09,12,17,19,22,25,28,31,32,1.2,0.8,0.9',
+            'RMC': 'GNRMC,%s,A,%s,%.3f,%.2f,%s,,,A' % (hms, position, ground_speed * KNOTS, course,
+                                                     time.strftime('%d%m%y', time.gmtime(utc))),
+            'VTG': 'GNVTG,%.2f,T,,M,%.3f,N,%.3f,K,A' % (course, ground_speed * KNOTS, ground_speed * 3.6),
+            'ZDA': 'GNZDA,%s,%s,00,00' % (hms, time.strftime('%d,%m,%Y', time.gmtime(utc))),
+            'GST': 'GNGST,%s,1.2,0.9,0.7,45.0,0.8,0.7,1.2' % hms,
+            'GSV': 'GPGSV,1,1,04,01,45,083,46,03,62,270,48,06,12,310,39,09,33,150,42',
+        }
+        return b''.join(nmea_sentence(sentence) for msg, sentence in sentences.items()
+                        if self.sentence_rates.get(msg, 0) > 0 and index % self.sentence_rates[msg] == 0)
+
+
+class AshtechReceiver(Receiver):
+    """
+    Ashtech/Trimble receiver with the $PASHS/$PASHQ command set, connected to port A. As an MB-Two it also
+    outputs the dual antenna heading (HDT, THS, HPR) once configured.
+    """
+
+    default_baudrate = 9600
+
+    SPEED_CODES = {0: 300, 1: 600, 2: 1200, 3: 2400, 4: 4800, 5: 9600, 6: 19200, 7: 38400, 8: 57600, 9: 115200}
+
+    def __init__(self, link, rate, mb_two):
+        super().__init__(link, rate)
+        self.mb_two = mb_two
+        self.periods = {}  # output period per NMEA message [s]
+        self.raw_periods = {}  # output period per raw (binary) message [s]
+
+    def handle_message(self, message):
+        if message[0] != 'nmea':
+            return False
+
+        fields = message[1].split(',')
+
+        if fields[:2] == ['PASHQ', 'PRT']:
+            # the baudrate is checked at startup, the driver can only select the ones of SPEED_CODES
+            code = next(c for c, b in self.SPEED_CODES.items() if b == self.link.baudrate)
+            self.link.send(nmea_sentence('PASHR,PRT,A,%i' % code))
+
+        elif fields[:2] == ['PASHQ', 'RID']:
+            self.link.send(nmea_sentence('PASHR,RID,%s,52,WNV35IUCLPXW_K,0006,,' % ('MB2' if self.mb_two else 'MB1')))
+
+        elif fields[0] == 'PASHS':
+            self.link.send(nmea_sentence('PASHR,ACK'))
+
+            if fields[1] == 'SPD' and len(fields) >= 4 and int(fields[3]) in self.SPEED_CODES:
+                self.change_baudrate(self.SPEED_CODES[int(fields[3])])
+
+            elif fields[1] == 'OUT' and len(fields) >= 4:
+                self.streaming = fields[3] == 'ON'
+
+            elif fields[1] in ('NME', 'RAW') and len(fields) >= 5:
+                periods = self.periods if fields[1] == 'NME' else self.raw_periods
+
+                if fields[2] == 'ALL':
+                    periods.clear()
+
+                elif fields[4] == 'ON':
+                    periods[fields[2]] = float(fields[5]) if len(fields) >= 6 else 1.0
+
+                else:
+                    periods.pop(fields[2], None)
+
+                all_periods = list(self.periods.values()) + list(self.raw_periods.values())
+                self.rate = 1.0 / min(all_periods) if all_periods else 1.0
+
+        else:
+            return False
+
+        return True
+
+    def epoch(self, utc, state, index):
+        lat, lon, alt, vel_n, vel_e, vel_d = state
+        hms = nmea_time(utc)
+        course = math.degrees(math.atan2(vel_e, vel_n)) % 360
+        sentences = {
+            'POS': 'PASHR,POS,0,14,%s,%s,%.3f,,%.2f,%.3f,%.1f,1.2,0.8,0.9,0.7,' %
+                   (hms, nmea_lat_lon(lat, lon), alt, course, math.hypot(vel_n, vel_e) * KNOTS, -vel_d * 10),
+            'GGA': 'GPGGA,%s,%s,1,14,0.8,%.3f,M,47.0,M,,' % (hms, nmea_lat_lon(lat, lon), alt - 47.0),
+            'GST': 'GPGST,%s,1.2,0.9,0.7,45.0,0.8,0.7,1.2' % hms,
+            'ZDA': 'GPZDA,%s,%s,00,00' % (hms, time.strftime('%d,%m,%Y', time.gmtime(utc))),
+            'GSV': 'GPGSV,1,1,04,01,45,083,46,03,62,270,48,06,12,310,39,09,33,150,42',
+        }
+
+        if self.mb_two:
+            # the antennas are mounted along the direction of flight
+            sentences.update({
+                'HDT': 'GPHDT,%.2f,T' % course,
+                'THS': 'GPTHS,%.2f,A' % course,
+                'HPR': 'PASHR,HPR,%s,%.2f,+0.50,,0.004,0.032,0,2,1' % (hms, course),
+            })
+
+        out = b''
+
+        if self.due(self.raw_periods, 'PBN', index):
+            out += self.pbn(utc, state)
+
+        return out + b''.join(nmea_sentence(sentence) for msg, sentence in sentences.items()
+                              if self.due(self.periods, msg, index))
+
+    def due(self, periods, msg, index):
+        return msg in periods and index % max(int(round(periods[msg] * self.nav_rate())), 1) == 0
+
+    @staticmethod
+    def pbn(utc, state):
+        """ @return a PBN message: big endian position & velocity block, followed by the sum of its 16 bit words """
+        _, itow = gps_time(utc)
+        (x, y, z), (vx, vy, vz) = ecef(*state)
+        block = struct.pack('>i4sdddfffffH', itow, b'PX4 ', x, y, z, 0.0, vx, vy, vz, 0.0, 120)
+        checksum = sum(struct.unpack('>%iH' % (len(block) // 2), block)) & 0xFFFF
+        return b'$PASHR,PBN,' + block + struct.pack('>H', checksum) + b'\r\n'
+
+
+class ErbReceiver(Receiver):
+    """ Emlid Reach with the ERB protocol enabled, it does not take any configuration """
+
+    default_baudrate = 115200
+
+    def __init__(self, link, rate, correction_age=None):
+        super().__init__(link, rate)
+        self.streaming = True
+        self.correction_age = correction_age  # age of the RTK corrections [s], None without RTK solution
+
+    @staticmethod
+    def frame(msg_id, payload):
+        body = struct.pack('<BH', msg_id, len(payload)) + payload
+        return b'ER' + body + fletcher(body)
+
+    def epoch(self, utc, state, index):
+        lat, lon, alt, vel_n, vel_e, vel_d = state
+        week, itow = gps_time(utc)
+        ground_speed = math.hypot(vel_n, vel_e)
+        out = b''
+
+        if index % max(int(round(self.nav_rate())), 1) == 0:
+            out += self.frame(0x01, struct.pack('<IBBB', itow, 1, 0, 0))
+            out += self.frame(0x06, struct.pack('<IB', itow, len(SATELLITES)) +
+                              b''.join(struct.pack('<BBBBiiihh', prn, 0, cn0, cn0 - 3, 0, 0, 0, azimuth, elevation)
+                                       for prn, elevation, azimuth, cn0 in SATELLITES))
+
+        if self.correction_age is not None:
+            age = min(int(round(self.correction_age * 100)), 0xFFFF)
+            out += self.frame(0x07, struct.pack('<BHiiiHHI', 12, age, 1200, -800, 150, 250, week, itow))
+
+        # fix type: 1 single, 3 RTK fixed
+        out += self.frame(0x03, struct.pack('<IHBBB', itow, week, 1 if self.correction_age is None else 3, 1, 14))
+        out += self.frame(0x04, struct.pack('<IHHHH', itow, 150, 120, 90, 80))
+        out += self.frame(0x02, struct.pack('<IddddII', itow, lon, lat, alt, alt - 47.0, 800, 1200))
+        out += self.frame(0x05, struct.pack('<IiiiIiI', itow, int(vel_n * 100), int(vel_e * 100), int(vel_d * 100),
+                                            int(ground_speed * 100),
+                                            int((math.degrees(math.atan2(vel_e, vel_n)) % 360) * 1e5), 15))
+        return out
+
+
+def read_dump(path):
+    """
+    Read the data received from the device in a communication dump file (GPS_DUMP_COMM = 2).
+    @return list of (timestamp [s], data)
+    """
+    header = struct.Struct('<QIHB')  # timestamp [us], sequence, length, flags
+    records = []
+
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    pos = 0
+
+    while pos + header.size <= len(data):
+        timestamp, _, length, flags = header.unpack_from(data, pos)
+        pos += header.size
+
+        if not flags & 0x01:
+            records.append((timestamp * 1e-6, data[pos:pos + length]))
+
+        pos += length
+
+    return records
+
+
+def main():
+    parser = argparse.ArgumentParser(description='GPS receiver emulator on a pseudo-terminal')
+    parser.add_argument('--protocol', choices=['ubx', 'nmea', 'ashtech', 'erb'], default='ubx')
+    parser.add_argument('--link', default='/tmp/ttyGPS', help='symlink to the pseudo-terminal for the driver')
+    parser.add_argument('--baudrate', type=int, help='initial baudrate of the receiver')
+    parser.add_argument('--rate', type=float, help='navigation rate [Hz], ignores the rate configured by the driver')
+    parser.add_argument('--ubx-generation', type=int, choices=[8, 9], default=8, help='u-blox generation')
+    parser.add_argument('--nmea-ublox', action='store_true', help='NMEA receiver answers the u-blox sentences')
+    parser.add_argument('--ashtech-mb-two', action='store_true',
+                        help='Ashtech receiver identifies as an MB-Two and outputs the dual antenna heading')
+    parser.add_argument('--erb-rtk', type=float, metavar='AGE',
+                        help='ERB receiver reports an RTK fixed solution with corrections of this age [s]')
+    parser.add_argument('--lat', type=float, default=47.3566094)
+    parser.add_argument('--lon', type=float, default=8.5190237)
+    parser.add_argument('--alt', type=float, default=488.0, help='altitude above the ellipsoid [m]')
+    parser.add_argument('--radius', type=float, default=50.0, help='circle radius [m], 0 for a fixed position')
+    parser.add_argument('--speed', type=float, default=5.0, help='speed on the circle [m/s]')
+    parser.add_argument('--replay', help='replay the received data of a communication dump instead of epochs')
+    parser.add_argument('--replay-speed', type=float, default=1.0, help='replay speed factor')
+    parser.add_argument('--stats-interval', type=float, default=5.0, help='[s]')
+    args = parser.parse_args()
+
+    receiver_classes = {'ubx': UbxReceiver, 'nmea': NmeaReceiver, 'ashtech': AshtechReceiver, 'erb': ErbReceiver}
+    baudrate = args.baudrate or receiver_classes[args.protocol].default_baudrate
+
+    if baudrate not in BAUDRATES.values():
+        parser.error('unsupported baudrate %i' % baudrate)
+
+    if args.protocol == 'ashtech' and baudrate not in AshtechReceiver.SPEED_CODES.values():
+        parser.error('baudrate %i has no Ashtech speed code' % baudrate)
+
+    link = Link(baudrate, args.link)
+
+    if args.protocol == 'ubx':
+        receiver = UbxReceiver(link, 1.0, args.ubx_generation)
+
+    elif args.protocol == 'nmea':
+        receiver = NmeaReceiver(link, 1.0, args.nmea_ublox)
+
+    elif args.protocol == 'ashtech':
+        receiver = AshtechReceiver(link, 1.0, args.ashtech_mb_two)
+
+    else:
+        receiver = ErbReceiver(link, 5.0, args.erb_rtk)
+
+    receiver.rate_override = args.rate
+    trajectory = Trajectory(args.lat, args.lon, args.alt, args.radius, args.speed)
+    replay = read_dump(args.replay) if args.replay else None
+
+    print('%s receiver on %s (%s), %i baud' % (args.protocol, link.path, args.link, link.baudrate))
+
+    start = time.monotonic()
+    utc_offset = time.time() - start
+    epoch_index = 0
+    epoch_start = None  # time of epoch 0, the epochs are scheduled from it so that they do not drift
+    replay_index = 0
+    epochs_sent = epochs_dropped = 0
+    last_epoch_size = 0
+    last_stats = start
+    last_tx_bytes = 0
+
+    try:
+        while True:
+            now = time.monotonic()
+
+            # next event: epoch, pending output or statistics
+            timeout = 0.001 if link.pending() else 0.05
+
+            if epoch_start is not None and not replay:
+                timeout = min(timeout, max(epoch_start + epoch_index / receiver.nav_rate() - now, 0.0))
+
+            readable, _, _ = select.select([link.master], [], [], timeout)
+            now = time.monotonic()
+
+            if readable:
+                data = link.read()
+
+                if data:
+                    receiver.handle_input(data, now - start)
+
+            receiver.update()
+
+            if receiver.streaming and link.in_sync():
+                if replay:
+                    # replay with the recorded timing, in a loop
+                    if epoch_start is None or replay_index >= len(replay):
+                        epoch_start = now - replay[0][0] / args.replay_speed
+                        replay_index = 0
+
+                    while replay_index < len(replay) and epoch_start + replay[replay_index][0] / args.replay_speed <= now:
+                        link.send(replay[replay_index][1])
+                        replay_index += 1
+
+                else:
+                    if epoch_start is None:
+                        epoch_start = now
+
+                    next_epoch = epoch_start + epoch_index / receiver.nav_rate()
+
+                    if now >= next_epoch:
+                        # an epoch only starts when the previous ones are (nearly) sent, like on a real receiver
+                        if last_epoch_size and link.pending() > last_epoch_size:
+                            epochs_dropped += 1
+
+                        else:
+                            t = next_epoch - epoch_start
+                            data = receiver.epoch(utc_offset + next_epoch, trajectory.state(t), epoch_index)
+                            link.send(data)
+                            last_epoch_size = len(data)
+                            epochs_sent += 1
+
+                        epoch_index += 1
+
+                        # the rate changed or we are far behind: restart the schedule
+                        if now - next_epoch > 1.0:
+                            epoch_start = None
+                            epoch_index = 0
+
+            else:
+                epoch_start = None
+                epoch_index = 0
+
+            link.service()
+
+            if now - last_stats >= args.stats_interval:
+                dt = now - last_stats
+                load = (link.tx_bytes - last_tx_bytes) * link.byte_time() / dt
+                print('[%7.1f s] baud %i (driver %i), configured at %s, %.1f Hz epochs, sent %i dropped %i, '
+                      'load %.0f %%, lost tx %i rx %i bytes' %
+                      (now - start, link.baudrate, link.peer_baudrate(),
+                       '%.2f s' % receiver.config_time if receiver.config_time is not None else '-',
+                       receiver.nav_rate(), epochs_sent, epochs_dropped, load * 100, link.tx_lost, link.rx_lost))
+                sys.stdout.flush()
+                last_stats = now
+                last_tx_bytes = link.tx_bytes
+
+    except KeyboardInterrupt:
+        pass
+
+    finally:
+        link.close()
+
+
+if __name__ == '__main__':
+    main()
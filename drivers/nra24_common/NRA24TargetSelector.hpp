@@ -0,0 +1,233 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file NRA24TargetSelector.hpp
+ *
+ * Groups the target frames of the NRA24 measurement cycles and selects one target per cycle,
+ * shared by the NRA24 drivers of PX4 1.8 and 1.11.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#include <drivers/drv_hrt.h>
+#include <mathlib/mathlib.h>
+
+#include "nra24_parser.h"
+
+class NRA24TargetSelector
+{
+public:
+	enum class Mode : int32_t {
+		Nearest = 0,
+		Strongest,
+		Consistent	///< target closest to the previously selected one
+	};
+
+	/**
+	 * @param mode target selection, NRA24_TGT_MODE
+	 * @param min_distance targets closer than this are clutter close to the antenna [m]
+	 */
+	void configure(Mode mode, float min_distance)
+	{
+		_mode = mode;
+		_min_distance = min_distance;
+	}
+
+	/**
+	 * Group the target info frames of a measurement cycle
+	 * @return the range of the selected target once a cycle is complete, -1 otherwise
+	 */
+	float handle_frame(const nra24_frame_s &frame, hrt_abstime timestamp_sample)
+	{
+		float distance_m = -1.0f;
+
+		if (frame.msg_id == NRA24_MSG_ID_TARGET_STATUS) {
+			// a new cycle starts, use the previous one if target info frames were lost
+			if (_num_targets > 0) {
+				distance_m = select_target();
+			}
+
+			_num_targets = 0;
+			_num_targets_expected = frame.num_targets;
+
+			// detect lost measurement cycles
+			_missed_cycles = 0;
+
+			if (_roll_count_valid) {
+				_missed_cycles = (frame.roll_count - _roll_count - 1) & ROLL_COUNT_MASK;
+			}
+
+			_roll_count = frame.roll_count;
+			_roll_count_valid = true;
+
+		} else if (frame.msg_id == NRA24_MSG_ID_TARGET_INFO) {
+			if (_num_targets < MAX_TARGETS) {
+				_targets[_num_targets].range = frame.range;
+				_targets[_num_targets].rcs = frame.rcs;
+				_targets[_num_targets].timestamp_sample = timestamp_sample;
+				_num_targets++;
+			}
+
+			// without a target status frame, every target info is handled as its own cycle
+			if (_num_targets >= _num_targets_expected) {
+				distance_m = select_target();
+				_num_targets = 0;
+				_num_targets_expected = 0;
+			}
+		}
+
+		return distance_m;
+	}
+
+	void reset()
+	{
+		_num_targets = 0;
+		_num_targets_expected = 0;
+		_roll_count_valid = false;
+		_missed_cycles = 0;
+		_selected_range = -1.0f;
+	}
+
+	Mode mode() const { return _mode; }
+	uint8_t roll_count() const { return _roll_count; }
+
+	/** Cycles lost before the one announced by the last target status frame */
+	uint8_t missed_cycles() const { return _missed_cycles; }
+
+	/** Sample timestamp of the selected target */
+	hrt_abstime timestamp() const { return _selected_timestamp; }
+
+	/** Signal quality of the selected target [0, 100] */
+	int8_t quality() const { return _selected_quality; }
+
+private:
+	static constexpr uint8_t MAX_TARGETS{8};
+	static constexpr uint8_t ROLL_COUNT_MASK{0x03};	///< the roll count is only compared modulo 4
+	static constexpr float RCS_MIN{-10.0f};		///< RCS mapped to 0 signal quality [dBsm]
+	static constexpr float RCS_MAX{30.0f};		///< RCS mapped to 100 signal quality [dBsm]
+
+	struct Target {
+		float range;	///< [m]
+		float rcs;	///< [dBsm]
+		hrt_abstime timestamp_sample;
+	};
+
+	/**
+	 * Select one of the targets of the current cycle, according to the mode
+	 * @return range of the selected target, -1 if there is no valid target
+	 */
+	float select_target()
+	{
+		int selected = -1;
+
+		for (int i = 0; i < _num_targets; i++) {
+			const Target &target = _targets[i];
+
+			// ignore clutter close to the antenna
+			if (target.range < _min_distance) {
+				continue;
+			}
+
+			if (selected < 0) {
+				selected = i;
+				continue;
+			}
+
+			switch (_mode) {
+			case Mode::Strongest:
+				if (target.rcs > _targets[selected].rcs) {
+					selected = i;
+				}
+
+				break;
+
+			case Mode::Consistent:
+				if (_selected_range >= 0.0f) {
+					if (fabsf(target.range - _selected_range) < fabsf(_targets[selected].range - _selected_range)) {
+						selected = i;
+					}
+
+					break;
+				}
+
+				// no previous range, use the nearest target
+				/* FALLTHROUGH */
+			case Mode::Nearest:
+			default:
+				if (target.range < _targets[selected].range) {
+					selected = i;
+				}
+
+				break;
+			}
+		}
+
+		if (selected < 0) {
+			return -1.0f;
+		}
+
+		_selected_range = _targets[selected].range;
+		_selected_timestamp = _targets[selected].timestamp_sample;
+
+		// signal quality: strength of the echo, reduced if it is ambiguous or cycles got lost
+		float quality = math::constrain((_targets[selected].rcs - RCS_MIN) / (RCS_MAX - RCS_MIN), 0.0f, 1.0f);
+
+		if (_num_targets > 1) {
+			quality *= 0.8f;
+		}
+
+		quality /= 1 + _missed_cycles;
+		_selected_quality = (int8_t)(quality * 100.0f);
+
+		return _selected_range;
+	}
+
+	Mode _mode{Mode::Nearest};
+	float _min_distance{0.0f};
+
+	Target _targets[MAX_TARGETS] {};
+	uint8_t _num_targets{0};		///< targets received in the current cycle
+	uint8_t _num_targets_expected{0};	///< targets announced by the last target status frame
+	uint8_t _roll_count{0};
+	bool _roll_count_valid{false};
+	uint8_t _missed_cycles{0};		///< cycles lost before the current one
+
+	float _selected_range{-1.0f};
+	hrt_abstime _selected_timestamp{0};
+	int8_t _selected_quality{-1};		///< signal quality [0, 100]
+};
@@ -0,0 +1,274 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file RangeFilter.hpp
+ *
+ * Filter stage for the range of the serial rangefinder drivers, shared by the NRA24 and TFMINI drivers of PX4 1.8 and 1.11.
+ */
+
+#pragma once
+
+#include <stdio.h>
+
+#include <drivers/drv_hrt.h>
+#include <mathlib/mathlib.h>
+#include <parameters/param.h>
+
+class RangeFilter
+{
+public:
+	enum class Type : int32_t {
+		Off = 0,	///< publish the raw range
+		EMA,		///< exponential moving average, gain alpha
+		AlphaBeta,	///< alpha-beta filter with velocity estimate
+		Kalman,		///< constant velocity Kalman filter with innovation gating
+		Median		///< median of the last MEDIAN_SIZE samples
+	};
+
+	/**
+	 * @param type filter type
+	 * @param alpha EMA gain / alpha-beta position gain
+	 * @param beta alpha-beta velocity gain
+	 * @param acc_noise Kalman process noise (vertical acceleration) [m/s^2]
+	 * @param range_noise Kalman measurement noise (standard deviation of the sensor) [m]
+	 * @param gate Kalman innovation gate [standard deviations], 0 to disable
+	 */
+	void configure(Type type, float alpha, float beta, float acc_noise, float range_noise, float gate)
+	{
+		_type = type;
+		_alpha = math::constrain(alpha, 0.0f, 1.0f);
+		_beta = math::constrain(beta, 0.0f, 1.0f);
+		_acc_noise = acc_noise;
+		_range_noise = range_noise;
+		_gate = gate;
+		reset();
+	}
+
+	/**
+	 * Configure from the <prefix>_FLT_* parameters
+	 * @param range_noise Kalman measurement noise (standard deviation of the sensor) [m]
+	 */
+	void configure_from_params(const char *prefix, float range_noise)
+	{
+		int32_t type = (int32_t)Type::EMA;
+		float alpha = 0.65f;
+		float beta = 0.1f;
+		float acc_noise = 2.0f;
+		float gate = 3.0f;
+
+		get_param(prefix, "TYPE", &type);
+		get_param(prefix, "ALPHA", &alpha);
+		get_param(prefix, "BETA", &beta);
+		get_param(prefix, "ACC", &acc_noise);
+		get_param(prefix, "GATE", &gate);
+
+		configure((Type)type, alpha, beta, acc_noise, range_noise, gate);
+	}
+
+	void reset()
+	{
+		_initialized = false;
+		_num_samples = 0;
+		_num_rejected = 0;
+	}
+
+	/**
+	 * Add a measurement
+	 * @return false if the measurement was rejected as an outlier, and no filtered range should be published
+	 */
+	bool update(float range, hrt_abstime timestamp)
+	{
+		_raw = range;
+
+		// restart after a gap in the data
+		if (_initialized && (timestamp <= _timestamp || timestamp - _timestamp > TIMEOUT)) {
+			reset();
+		}
+
+		const float dt = _initialized ? (timestamp - _timestamp) * 1e-6f : 0.0f;
+		_timestamp = timestamp;
+
+		if (!_initialized) {
+			initialize(range);
+		}
+
+		switch (_type) {
+		case Type::EMA:
+			_range += _alpha * (range - _range);
+			break;
+
+		case Type::AlphaBeta: {
+				const float predicted = _range + _velocity * dt;
+				const float residual = range - predicted;
+				_range = predicted + _alpha * residual;
+
+				if (dt > 0.0f) {
+					_velocity += _beta * residual / dt;
+				}
+			}
+			break;
+
+		case Type::Kalman:
+			return update_kalman(range, dt);
+
+		case Type::Median:
+			_range = update_median(range);
+			break;
+
+		case Type::Off:
+		default:
+			_range = range;
+			break;
+		}
+
+		return true;
+	}
+
+	float raw() const { return _raw; }
+	float filtered() const { return _range; }
+	unsigned rejected() const { return _num_rejected_total; }
+
+private:
+	static constexpr hrt_abstime TIMEOUT{500000};	///< reset the filter after this time without data [us]
+	static constexpr int MEDIAN_SIZE{5};
+	static constexpr unsigned MAX_CONSECUTIVE_REJECTIONS{10};
+
+	static void get_param(const char *prefix, const char *name, void *value)
+	{
+		char param_name[17];
+		snprintf(param_name, sizeof(param_name), "%s_FLT_%s", prefix, name);
+		param_t handle = param_find(param_name);
+
+		if (handle != PARAM_INVALID) {
+			param_get(handle, value);
+		}
+	}
+
+	void initialize(float range)
+	{
+		_range = range;
+		_velocity = 0.0f;
+		_p_range = _range_noise * _range_noise;
+		_p_range_vel = 0.0f;
+		_p_vel = 1.0f;
+		_initialized = true;
+	}
+
+	bool update_kalman(float range, float dt)
+	{
+		// predict
+		const float dt2 = dt * dt;
+		const float q = _acc_noise * _acc_noise;
+		_range += _velocity * dt;
+		_p_range += dt * (2.0f * _p_range_vel + dt * _p_vel) + 0.25f * dt2 * dt2 * q;
+		_p_range_vel += dt * _p_vel + 0.5f * dt2 * dt * q;
+		_p_vel += dt2 * q;
+
+		// innovation gating
+		const float innovation = range - _range;
+		const float innovation_var = _p_range + _range_noise * _range_noise;
+
+		if (_gate > 0.0f && innovation * innovation > _gate * _gate * innovation_var) {
+			_num_rejected_total++;
+
+			// do not lock out a real step in the range (e.g. flying over an edge) forever
+			if (++_num_rejected < MAX_CONSECUTIVE_REJECTIONS) {
+				return false;
+			}
+
+			initialize(range);
+			_num_rejected = 0;
+			return true;
+		}
+
+		_num_rejected = 0;
+
+		// update
+		const float k_range = _p_range / innovation_var;
+		const float k_vel = _p_range_vel / innovation_var;
+		_range += k_range * innovation;
+		_velocity += k_vel * innovation;
+		_p_vel -= k_vel * _p_range_vel;
+		_p_range_vel -= k_range * _p_range_vel;
+		_p_range -= k_range * _p_range;
+
+		return true;
+	}
+
+	float update_median(float range)
+	{
+		_samples[_num_samples % MEDIAN_SIZE] = range;
+		_num_samples++;
+
+		const int n = math::min((int)_num_samples, MEDIAN_SIZE);
+		float sorted[MEDIAN_SIZE];
+
+		// insertion sort, n is small
+		for (int i = 0; i < n; i++) {
+			float value = _samples[i];
+			int j = i;
+
+			for (; j > 0 && sorted[j - 1] > value; j--) {
+				sorted[j] = sorted[j - 1];
+			}
+
+			sorted[j] = value;
+		}
+
+		return sorted[n / 2];
+	}
+
+	Type _type{Type::Off};
+	float _alpha{1.0f};
+	float _beta{0.0f};
+	float _acc_noise{1.0f};
+	float _range_noise{0.1f};
+	float _gate{0.0f};
+
+	bool _initialized{false};
+	hrt_abstime _timestamp{0};
+	float _raw{0.0f};
+	float _range{0.0f};
+	float _velocity{0.0f};
+
+	// Kalman filter covariance
+	float _p_range{0.0f};
+	float _p_range_vel{0.0f};
+	float _p_vel{0.0f};
+	unsigned _num_rejected{0};
+	unsigned _num_rejected_total{0};
+
+	float _samples[MEDIAN_SIZE] {};
+	unsigned _num_samples{0};
+};
@@ -0,0 +1,227 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file SerialFrameDecoder.hpp
+ *
+ * Decoder for serial protocols with fixed-length frames, shared by the NRA24 and TFMINI drivers of PX4 1.8 and 1.11.
+ * The frame layout is a compile-time parameter, so that the validation is fully specialized per protocol.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#include <drivers/drv_hrt.h>
+
+namespace serial_frame
+{
+
+enum class Checksum {
+	None,
+	Sum8	///< low 8 bits of the sum of the bytes
+};
+
+/**
+ * Layout of a fixed-length frame, starting with 2 sync bytes.
+ * A protocol derives from it and adds the frame type and the field extractor:
+ *
+ *   using Frame = ...;
+ *   static bool decode(const uint8_t *buf, Frame &frame); // false if the frame is valid, but not used
+ *
+ * @tparam Length frame length [bytes]
+ * @tparam ChecksumStart first byte included in the checksum
+ * @tparam ChecksumEnd position of the checksum byte, the bytes [ChecksumStart, ChecksumEnd) are included
+ * @tparam Trailer value of the last 2 bytes (first byte in the high byte), -1 if there is no trailer
+ */
+template<uint8_t Sync1, uint8_t Sync2, unsigned Length, Checksum ChecksumType, unsigned ChecksumStart,
+	 unsigned ChecksumEnd, int32_t Trailer = -1>
+struct FrameLayout {
+	static constexpr uint8_t SYNC1 = Sync1;
+	static constexpr uint8_t SYNC2 = Sync2;
+	static constexpr unsigned LENGTH = Length;
+
+	static_assert(ChecksumType == Checksum::None || (ChecksumStart < ChecksumEnd && ChecksumEnd < Length),
+		      "invalid checksum range");
+
+	/** @return true if buf (at least LENGTH bytes, starting with SYNC1) holds a valid frame */
+	static bool valid(const uint8_t *buf)
+	{
+		if (buf[1] != Sync2) {
+			return false;
+		}
+
+		if (ChecksumType == Checksum::Sum8) {
+			uint8_t checksum = 0;
+
+			for (unsigned i = ChecksumStart; i < ChecksumEnd; i++) {
+				checksum += buf[i];
+			}
+
+			if (buf[ChecksumEnd] != checksum) {
+				return false;
+			}
+		}
+
+		if (Trailer >= 0) {
+			if (buf[Length - 2] != ((Trailer >> 8) & 0xFF) || buf[Length - 1] != (Trailer & 0xFF)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+};
+
+/**
+ * Reads from a serial port, decodes the frames of a Protocol and timestamps them.
+ * Bytes of an incomplete frame are kept for the next read.
+ * @tparam BufferFrames size of the receive buffer [frames]
+ */
+template<typename Protocol, unsigned BufferFrames = 4>
+class SerialFrameDecoder
+{
+public:
+	using Frame = typename Protocol::Frame;
+
+	/**
+	 * @param byte_time time to transmit 1 byte, used to back-compute the frame timestamps [us]
+	 * @param latency sensor latency, subtracted from the frame timestamps [us]
+	 */
+	void configure(uint32_t byte_time, uint32_t latency)
+	{
+		_byte_time = byte_time;
+		_latency = latency;
+	}
+
+	/**
+	 * Read all available bytes and decode them.
+	 * on_frame(const Frame &frame, hrt_abstime timestamp_sample) is called for each valid frame.
+	 * The sample timestamp is the read completion time, minus the transmission of the bytes received after
+	 * the frame (including the ones not read yet) and of the frame itself, minus the latency.
+	 * @return number of bytes read, 0 if no data was available, <0 on read error
+	 */
+	template<typename Callback>
+	int collect(int fd, Callback on_frame)
+	{
+		int bytes_available = 0;
+		::ioctl(fd, FIONREAD, (unsigned long)&bytes_available);
+
+		if (bytes_available <= 0) {
+			return 0;
+		}
+
+		int bytes_read = 0;
+		int ret = 0;
+
+		do {
+			ret = ::read(fd, &_buf[_len], sizeof(_buf) - _len);
+
+			if (ret < 0) {
+				return ret;
+			}
+
+			const hrt_abstime read_time = hrt_absolute_time();
+			_len += ret;
+			bytes_read += ret;
+			bytes_available -= ret;
+
+			const unsigned parsed = decode(read_time, bytes_available > 0 ? bytes_available : 0, on_frame);
+
+			_len -= parsed;
+			memmove(&_buf[0], &_buf[parsed], _len);
+
+		} while (ret > 0 && bytes_available > 0);
+
+		return bytes_read;
+	}
+
+	/** Drop all buffered bytes */
+	void reset() { _len = 0; }
+
+private:
+	/** @return number of bytes that can be dropped from the buffer */
+	template<typename Callback>
+	unsigned decode(hrt_abstime read_time, unsigned bytes_pending, Callback &on_frame)
+	{
+		unsigned pos = 0;
+
+		while (pos < _len) {
+			const uint8_t *start = (const uint8_t *)memchr(&_buf[pos], Protocol::SYNC1, _len - pos);
+
+			if (start == nullptr) {
+				return _len;
+			}
+
+			pos = start - _buf;
+
+			if (_len - pos < Protocol::LENGTH) {
+				// incomplete frame, keep it unless it is already clear that it is none
+				if (pos + 1 < _len && _buf[pos + 1] != Protocol::SYNC2) {
+					pos++;
+					continue;
+				}
+
+				break;
+			}
+
+			if (!Protocol::valid(&_buf[pos])) {
+				pos++;
+				continue;
+			}
+
+			Frame frame{};
+			const bool used = Protocol::decode(&_buf[pos], frame);
+			pos += Protocol::LENGTH;
+
+			if (used) {
+				const unsigned bytes_after_frame = (_len - pos) + bytes_pending;
+				on_frame(frame, read_time - (bytes_after_frame + Protocol::LENGTH) * _byte_time - _latency);
+			}
+		}
+
+		return pos;
+	}
+
+	uint8_t _buf[Protocol::LENGTH * BufferFrames] {};
+	unsigned _len{0};
+
+	uint32_t _byte_time{87};	///< 115200 bps
+	uint32_t _latency{0};
+};
+
+} // namespace serial_frame
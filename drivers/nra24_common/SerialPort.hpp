@@ -0,0 +1,129 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+
+/**
+ * @file SerialPort.hpp
+ *
+ * Serial port setup shared by the NRA24 and TFMINI drivers of PX4 1.8 and 1.11.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#ifdef __PX4_LINUX
+#include <linux/serial.h>
+#endif /* __PX4_LINUX */
+
+#include <px4_log.h>
+
+/**
+ * Open a serial port for a binary protocol: raw mode, 8N1, no flow control.
+ * The port is meant to stay open for the lifetime of the driver.
+ * @param port device path
+ * @param speed baud rate (B115200, ...)
+ * @param vmin minimum number of bytes for a read to return
+ * @param vtime read timeout [0.1 s], 0 together with vmin = 0 for non-blocking reads
+ * @return fd on success, <0 otherwise
+ */
+static inline int serial_port_open(const char *port, speed_t speed, uint8_t vmin = 0, uint8_t vtime = 0)
+{
+	int fd = ::open(port, O_RDWR | O_NOCTTY);
+
+	if (fd < 0) {
+		PX4_ERR("open %s failed", port);
+		return -1;
+	}
+
+	termios uart_config{};
+
+	if (tcgetattr(fd, &uart_config) < 0) {
+		PX4_ERR("%s: get attributes failed", port);
+		::close(fd);
+		return -1;
+	}
+
+	uart_config.c_cflag |= (CLOCAL | CREAD);	// ignore modem controls
+	uart_config.c_cflag &= ~CSIZE;
+	uart_config.c_cflag |= CS8;			// 8-bit characters
+	uart_config.c_cflag &= ~PARENB;			// no parity bit
+	uart_config.c_cflag &= ~CSTOPB;			// only need 1 stop bit
+	uart_config.c_cflag &= ~CRTSCTS;		// no hardware flowcontrol
+
+	// raw mode: no line buffering, echo, signals or byte translation
+	uart_config.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF | IXANY);
+	uart_config.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+	uart_config.c_oflag &= ~(OPOST | ONLCR);
+
+	uart_config.c_cc[VMIN] = vmin;
+	uart_config.c_cc[VTIME] = vtime;
+
+	if (cfsetispeed(&uart_config, speed) < 0 || cfsetospeed(&uart_config, speed) < 0) {
+		PX4_ERR("%s: set baud rate failed", port);
+		::close(fd);
+		return -1;
+	}
+
+	// apply all settings at once, after they are complete
+	if (tcsetattr(fd, TCSANOW, &uart_config) < 0) {
+		PX4_ERR("%s: set attributes failed", port);
+		::close(fd);
+		return -1;
+	}
+
+#ifdef __PX4_LINUX
+	// hand received bytes to user space right away instead of after the (up to 16 ms) tty flip buffer delay.
+	// Not all serial drivers (e.g. USB adapters) support it, so this is not an error.
+	serial_struct serial{};
+
+	if (ioctl(fd, TIOCGSERIAL, &serial) == 0) {
+		serial.flags |= ASYNC_LOW_LATENCY;
+
+		if (ioctl(fd, TIOCSSERIAL, &serial) < 0) {
+			PX4_WARN("%s: low latency mode not supported", port);
+		}
+	}
+
+#endif /* __PX4_LINUX */
+
+	// drop anything received before the port was configured
+	tcflush(fd, TCIFLUSH);
+
+	return fd;
+}
@@ -64,22 +64,50 @@
  *                      //0x290=0x01+0xC8+0x07+0xD0+0x00+0x02+0xEE
 */
 
-enum class NRA24_PARSE_STATE {
-	NRA24_DECODE_INT = 0,
-	NRA24_DECODE_ENDSEQ1,
-	NRA24_DECODE_ENDSEQ2,
-	// NRA24_DECODE_STARTSEQ1,
-	// NRA24_DECODE_STARTSEQ2,
-	NRA24_DECODE_MESG_ID_L,
-	NRA24_DECODE_MESG_ID_H,
-	NRA24_DECODE_INDEX,
-	NRA24_DECODE_RCS,
-	NRA24_DECODE_RANGE_H,
-	NRA24_DECODE_RANGE_L,
-	NRA24_DECODE_RSVD1,
-	NRA24_DECODE_ROLLCOUNT_A,
-	NRA24_DECODE_ROLLCOUNT_B,
-	NRA24_DECODE_CHECKSUM
+#include <stdint.h>
+
+#include "SerialFrameDecoder.hpp"
+
+#define NRA24_MSG_ID_TARGET_STATUS	0x70B	///< number of targets, sent at the start of each measurement cycle
+#define NRA24_MSG_ID_TARGET_INFO	0x70C	///< one per target
+
+/** Decoded frame */
+struct nra24_frame_s {
+	uint16_t msg_id;	///< NRA24_MSG_ID_TARGET_STATUS or NRA24_MSG_ID_TARGET_INFO
+	uint8_t num_targets;	///< number of targets in this cycle (target status only)
+	uint8_t roll_count;	///< measurement cycle counter
+	uint8_t index;		///< target index (target info only)
+	float rcs;		///< radar cross section (target info only) [dBsm]
+	float range;		///< (target info only) [m]
 };
 
-int nra24_parse(char c, char *parserbuf, unsigned *parserbuf_index, NRA24_PARSE_STATE *state, float *dist, int *roll_count);
+#define NRA24_FRAME_SIZE	14	///< all frames have the same size
+
+/**
+ * Frame layout: 0xAA 0xAA start sequence, checksum over the payload, 0x55 0x55 end sequence
+ */
+struct NRA24Protocol : public serial_frame::FrameLayout<0xAA, 0xAA, NRA24_FRAME_SIZE, serial_frame::Checksum::Sum8, 4, 11, 0x5555> {
+	using Frame = nra24_frame_s;
+
+	static bool decode(const uint8_t *buf, Frame &frame)
+	{
+		const uint8_t *payload = &buf[4];
+		frame.msg_id = buf[2] | buf[3] << 8;
+
+		if (frame.msg_id == NRA24_MSG_ID_TARGET_INFO) {
+			frame.index = payload[0];
+			frame.rcs = payload[1] * 0.5f - 50.0f;
+			frame.range = (payload[2] * 256 + payload[3]) * 0.01f;
+			frame.roll_count = (payload[5] & 0xE0) >> 5;
+			return true;
+
+		} else if (frame.msg_id == NRA24_MSG_ID_TARGET_STATUS) {
+			frame.num_targets = payload[0];
+			frame.roll_count = payload[1];
+			return true;
+		}
+
+		// valid, but unused message
+		return false;
+	}
+};
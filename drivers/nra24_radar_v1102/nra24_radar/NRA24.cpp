@@ -33,17 +33,32 @@
 
 #include "NRA24.hpp"
 #include <systemlib/mavlink_log.h>
+#include <ctype.h>
 extern orb_advert_t mavlink_log_pub;
 
-NRA24::NRA24(const char *port, uint8_t rotation) :
-	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::hp_default),
-	_px4_rangefinder(0 /* TODO: device id */, ORB_PRIO_DEFAULT, rotation)
+NRA24::NRA24(const char *port, uint8_t rotation, bool obstacle_mode) :
+	ScheduledWorkItem(MODULE_NAME, px4::serial_port_to_wq(port)),
+	_px4_rangefinder(get_device_id(port), ORB_PRIO_DEFAULT, rotation),
+	_rotation(rotation),
+	_obstacle_mode(obstacle_mode)
 {
 	// store port name
 	strncpy(_port, port, sizeof(_port) - 1);
 
 	// enforce null termination
 	_port[sizeof(_port) - 1] = '\0';
+
+	// separate counters per instance, e.g. "nra24 ttyS2: read"
+	const char *port_name = strrchr(_port, '/');
+	port_name = (port_name != nullptr) ? port_name + 1 : _port;
+
+	snprintf(_comms_errors_name, sizeof(_comms_errors_name), MODULE_NAME" %s: com_err", port_name);
+	snprintf(_sample_perf_name, sizeof(_sample_perf_name), MODULE_NAME" %s: read", port_name);
+	snprintf(_dropped_cycles_name, sizeof(_dropped_cycles_name), MODULE_NAME" %s: dropped cycles", port_name);
+
+	_comms_errors = perf_alloc(PC_COUNT, _comms_errors_name);
+	_sample_perf = perf_alloc(PC_ELAPSED, _sample_perf_name);
+	_dropped_cycles = perf_alloc(PC_COUNT, _dropped_cycles_name);
 }
 
 NRA24::~NRA24()
@@ -51,8 +66,31 @@ NRA24::~NRA24()
 	// make sure we are truly inactive
 	stop();
 
+	if (_fd >= 0) {
+		::close(_fd);
+	}
+
 	perf_free(_sample_perf);
 	perf_free(_comms_errors);
+	perf_free(_dropped_cycles);
+}
+
+uint32_t
+NRA24::get_device_id(const char *port)
+{
+	// the port number is the trailing number of the device path
+	const char *number = port + strlen(port);
+
+	while (number > port && isdigit(*(number - 1))) {
+		number--;
+	}
+
+	device::Device::DeviceId device_id{};
+	device_id.devid_s.bus_type = device::Device::DeviceBusType_UNKNOWN;
+	device_id.devid_s.bus = atoi(number);
+	device_id.devid_s.devtype = DRV_DIST_DEVTYPE_NRA24;
+
+	return device_id.devid;
 }
 
 int
@@ -64,8 +102,7 @@ NRA24::init()
 	case 1: // NRA24 (12m, 100 Hz)
 		_px4_rangefinder.set_min_distance(NRA24_MIN_DISTANCE);
 		_px4_rangefinder.set_max_distance(NRA24_MAX_DISTANCE);
-		_px4_rangefinder.set_fov(math::radians(18.0f));
-		distance_track = 0.0f;
+		_px4_rangefinder.set_fov(math::radians(NRA24_FOV));
 
 		break;
 
@@ -74,80 +111,59 @@ NRA24::init()
 		return -1;
 	}
 
-	// status
-	int ret = 0;
+	int32_t target_mode = 0;
+	param_t handle = param_find("NRA24_TGT_MODE");
 
-	do { // create a scope to handle exit conditions using break
+	if (handle != PARAM_INVALID) {
+		param_get(handle, &target_mode);
+	}
 
-		// open fd
-		_fd = ::open(_port, O_RDWR | O_NOCTTY);
+	NRA24TargetSelector::Mode mode = (NRA24TargetSelector::Mode)target_mode;
 
-		if (_fd < 0) {
-			PX4_ERR("Error opening fd");
+	if (_obstacle_mode) {
+		// the sectors are only defined for horizontal rotations (multiples of 45 deg yaw)
+		if (_rotation > distance_sensor_s::ROTATION_FORWARD_FACING + 7) {
+			PX4_ERR("obstacle mode needs a horizontal rotation");
 			return -1;
 		}
 
-		// baudrate 115200, 8 bits, no parity, 1 stop bit
-		unsigned speed = B115200;
-		termios uart_config{};
-		int termios_state{};
-
-		tcgetattr(_fd, &uart_config);
+		// the nearest target is the relevant obstacle
+		mode = NRA24TargetSelector::Mode::Nearest;
 
-		// clear ONLCR flag (which appends a CR for every LF)
-		uart_config.c_oflag &= ~ONLCR;
+		int32_t obstacle_hold_ms = 300;
+		handle = param_find("NRA24_OBST_HOLD");
 
-		// set baud rate
-		if ((termios_state = cfsetispeed(&uart_config, speed)) < 0) {
-			PX4_ERR("CFG: %d ISPD", termios_state);
-			ret = -1;
-			break;
+		if (handle != PARAM_INVALID) {
+			param_get(handle, &obstacle_hold_ms);
 		}
 
-		if ((termios_state = cfsetospeed(&uart_config, speed)) < 0) {
-			PX4_ERR("CFG: %d OSPD\n", termios_state);
-			ret = -1;
-			break;
-		}
+		_obstacle_hold = math::max(obstacle_hold_ms, (int32_t)0) * 1000;
+	}
 
-		if ((termios_state = tcsetattr(_fd, TCSANOW, &uart_config)) < 0) {
-			PX4_ERR("baud %d ATTR", termios_state);
-			ret = -1;
-			break;
-		}
+	_target_selector.configure(mode, NRA24_MIN_DISTANCE);
 
-		uart_config.c_cflag |= (CLOCAL | CREAD);	// ignore modem controls
-		uart_config.c_cflag &= ~CSIZE;
-		uart_config.c_cflag |= CS8;			// 8-bit characters
-		uart_config.c_cflag &= ~PARENB;			// no parity bit
-		uart_config.c_cflag &= ~CSTOPB;			// only need 1 stop bit
-		uart_config.c_cflag &= ~CRTSCTS;		// no hardware flowcontrol
-
-		// setup for non-canonical mode
-		uart_config.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON);
-		uart_config.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
-		uart_config.c_oflag &= ~OPOST;
-
-		// fetch bytes as they become available
-		uart_config.c_cc[VMIN] = 1;
-		uart_config.c_cc[VTIME] = 1;
-
-		if (_fd < 0) {
-			PX4_ERR("FAIL: laser fd");
-			ret = -1;
-			break;
-		}
-	} while (0);
+	float latency_ms = 0.0f;
+	handle = param_find("NRA24_LATENCY");
 
-	// close the fd
-	::close(_fd);
-	_fd = -1;
+	if (handle != PARAM_INVALID) {
+		param_get(handle, &latency_ms);
+	}
 
-	if (ret == PX4_OK) {
-		start();
+	_latency = (uint32_t)(math::max(latency_ms, 0.0f) * 1000.0f);
+	_decoder.configure(NRA24_BYTE_TIME, _latency);
+
+	_filter.configure_from_params("NRA24", NRA24_RANGE_NOISE);
+
+	// baudrate 115200, 8 bits, no parity, 1 stop bit, non-blocking reads: the available bytes are polled
+	_fd = serial_port_open(_port, B115200);
+
+	if (_fd < 0) {
+		return -1;
 	}
 
-	return ret;
+	start();
+
+	return PX4_OK;
 }
 
 int
@@ -158,59 +174,61 @@ NRA24::collect()
 	// clear buffer if last read was too long ago
 	int64_t read_elapsed = hrt_elapsed_time(&_last_read);
 
-	// the buffer for read chars is buflen minus null termination
-	char readbuf[sizeof(_linebuf)] {};
-	unsigned readlen = sizeof(readbuf) - 1;
-	int ret = 0;
 	float distance_m = -1.0f;
-	int roll_count = -1;
 
-	// Check the number of bytes available in the buffer
-	int bytes_available = 0;
-	::ioctl(_fd, FIONREAD, (unsigned long)&bytes_available);
+	// decode all complete frames, the bytes of an incomplete frame are kept for the next read
+	int ret = _decoder.collect(_fd, [this, &distance_m](const nra24_frame_s & frame, hrt_abstime timestamp_sample) {
+		const float distance = _target_selector.handle_frame(frame, timestamp_sample);
 
-	if (!bytes_available) {
-		perf_end(_sample_perf);
-		return -EAGAIN;
-	}
+		if (frame.msg_id == NRA24_MSG_ID_TARGET_STATUS) {
+			_empty_cycle = (frame.num_targets == 0);
 
-	// parse entire buffer
-	const hrt_abstime timestamp_sample = hrt_absolute_time();
+			if (_target_selector.missed_cycles() > 0) {
+				perf_add(_dropped_cycles, _target_selector.missed_cycles());
+			}
+		}
 
-	do {
-		// read from the sensor (uart buffer)
-		ret = ::read(_fd, &readbuf[0], readlen);
-		if (ret < 0) {
-			PX4_ERR("read err: %d", ret);
-			perf_count(_comms_errors);
-			perf_end(_sample_perf);
+		if (distance >= 0.0f) {
+			distance_m = distance;
+		}
+	});
 
-			// only throw an error if we time out
-			if (read_elapsed > (NRA24_MEASURE_INTERVAL * 3)) {
-				/* flush anything in RX buffer */
-				tcflush(_fd, TCIFLUSH);
-				PX4_INFO("flush anything in RX buffer");
+	if (ret < 0) {
+		PX4_ERR("read err: %d", ret);
+		perf_count(_comms_errors);
+		perf_end(_sample_perf);
 
-				return ret;
+		// only throw an error if we time out
+		if (read_elapsed > (NRA24_MEASURE_INTERVAL * 3)) {
+			/* flush anything in RX buffer */
+			tcflush(_fd, TCIFLUSH);
+			_decoder.reset();
+			PX4_INFO("flush anything in RX buffer");
 
-			} else {
-				return -EAGAIN;
-			}
+			return ret;
+
+		} else {
+			return -EAGAIN;
 		}
+	}
 
+	if (ret > 0) {
 		_last_read = hrt_absolute_time();
+	}
 
-		// parse buffer
-		for (int i = 0; i < ret; i++) {
-			nra24_parse(readbuf[i], _linebuf, &_linebuf_index, &_parse_state, &distance_m, &roll_count);
+	if (_obstacle_mode) {
+		// publish once per cycle, also without targets so that obstacles expire
+		if (distance_m < 0.0f && !_empty_cycle) {
+			perf_end(_sample_perf);
+			return -EAGAIN;
 		}
 
-		// mavlink_log_info(&mavlink_log_pub, "Nra24 roll_count------- %d\r\n", (int)roll_count);
+		publish_obstacle_distance(distance_m, distance_m >= 0.0f ? _target_selector.timestamp() : _last_read);
+		_empty_cycle = false;
 
-		// bytes left to parse
-		bytes_available -= ret;
-
-	} while (bytes_available > 0);
+		perf_end(_sample_perf);
+		return PX4_OK;
+	}
 
 	// no valid measurement after parsing buffer
 	if (distance_m < 0.0f) {
@@ -218,25 +236,61 @@ NRA24::collect()
 		return -EAGAIN;
 	}
 
-	float _distance_temp;
-	_distance_temp = distance_track + 0.65f * (distance_m - distance_track);
-	distance_track = _distance_temp;
-
-	// mavlink_log_info(&mavlink_log_pub, "Nra24 current distance------- %.2f m\r\n", (double)distance_track);
+	// drop outliers
+	if (!_filter.update(distance_m, _target_selector.timestamp())) {
+		perf_end(_sample_perf);
+		return PX4_OK;
+	}
 
 	// publish most recent valid measurement from buffer
-	_px4_rangefinder.update(timestamp_sample, distance_track);
+	_px4_rangefinder.update(_target_selector.timestamp(), _filter.filtered(), _target_selector.quality());
 
 	perf_end(_sample_perf);
 
 	return PX4_OK;
 }
 
+void
+NRA24::publish_obstacle_distance(float range, hrt_abstime timestamp_sample)
+{
+	if (range >= 0.0f) {
+		_obstacle_range = range;
+		_obstacle_timestamp = timestamp_sample;
+	}
+
+	obstacle_distance_s obstacle_distance{};
+	obstacle_distance.timestamp = timestamp_sample;
+	obstacle_distance.frame = obstacle_distance_s::MAV_FRAME_BODY_FRD;
+	obstacle_distance.sensor_type = obstacle_distance_s::MAV_DISTANCE_SENSOR_RADAR;
+	obstacle_distance.increment = NRA24_OBST_INCREMENT;
+	obstacle_distance.min_distance = (uint16_t)(NRA24_MIN_DISTANCE * 100.0f);
+	obstacle_distance.max_distance = (uint16_t)(NRA24_MAX_DISTANCE * 100.0f);
+	obstacle_distance.angle_offset = 0.0f;
+
+	// hold the last obstacle over a few cycles without target, to not flicker, then report free space
+	uint16_t distance = obstacle_distance.max_distance + 1;
+
+	if (_obstacle_range >= 0.0f && timestamp_sample < _obstacle_timestamp + _obstacle_hold) {
+		distance = (uint16_t)(_obstacle_range * 100.0f);
+	}
+
+	// sectors outside of the field of view are unknown
+	const float yaw = _rotation * 45.0f;
+
+	for (uint8_t i = 0; i < NRA24_OBST_BINS; i++) {
+		// angle from the sensor axis, in [-180, 180)
+		const float angle = fmodf(i * NRA24_OBST_INCREMENT - yaw + 540.0f, 360.0f) - 180.0f;
+		obstacle_distance.distances[i] = (fabsf(angle) <= NRA24_FOV / 2.0f) ? distance : UINT16_MAX;
+	}
+
+	_obstacle_distance_pub.publish(obstacle_distance);
+}
+
 void
 NRA24::start()
 {
 	// schedule a cycle to start things
-	ScheduleOnInterval(100_us);
+	ScheduleNow();
 }
 
 void
@@ -248,27 +302,38 @@ NRA24::stop()
 void
 NRA24::Run()
 {
-	// fds initialized?
-	if (_fd < 0) {
-		// open fd
-		_fd = ::open(_port, O_RDWR | O_NOCTTY);
-	}
-
 	// perform collection
-	if (collect() == -EAGAIN) {
-		// reschedule to grab the missing bits, time to transmit 9 bytes @ 115200 bps
-		ScheduleClear();
-		ScheduleOnInterval(100_us, 87 * 9);
-		return;
+	int ret = collect();
+
+	if (ret == PX4_OK) {
+		// the next measurement cycle starts after the measurement interval,
+		// wake up a few frames early to not add latency
+		ScheduleDelayed(NRA24_MEASURE_INTERVAL - 2 * NRA24_FRAME_TIME);
+
+	} else if (ret == -EAGAIN) {
+		// reschedule to grab the missing bits, time to transmit one frame @ 115200 bps
+		ScheduleDelayed(NRA24_FRAME_TIME);
+
+	} else {
+		ScheduleDelayed(NRA24_MEASURE_INTERVAL);
 	}
 }
 
 void
 NRA24::print_info()
 {
-	printf("Using port '%s'\n", _port);
+	printf("Using port '%s', device id: %u\n", _port, (unsigned)get_device_id(_port));
+
+	if (_obstacle_mode) {
+		printf("obstacle mode, rotation: %d, last obstacle: %.2f m\n", _rotation, (double)_obstacle_range);
+	}
+
+	printf("target mode: %d, last roll count: %d\n", (int)_target_selector.mode(), _target_selector.roll_count());
+	printf("range raw: %.2f m, filtered: %.2f m, rejected: %u\n", (double)_filter.raw(), (double)_filter.filtered(),
+	       _filter.rejected());
 	perf_print_counter(_sample_perf);
 	perf_print_counter(_comms_errors);
+	perf_print_counter(_dropped_cycles);
 
 	_px4_rangefinder.print_status();
 }
@@ -47,58 +47,109 @@
 #include <termios.h>
 
 #include <drivers/drv_hrt.h>
+#include <drivers/drv_sensor.h>
 #include <lib/perf/perf_counter.h>
+#include <parameters/param.h>
 #include <px4_config.h>
 #include <px4_module.h>
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <lib/drivers/device/Device.hpp>
 #include <lib/drivers/rangefinder/PX4Rangefinder.hpp>
+#include <uORB/PublicationMulti.hpp>
 #include <uORB/topics/distance_sensor.h>
+#include <uORB/topics/obstacle_distance.h>
 #include <uORB/uORB.h>
 
 #include "nra24_parser.h"
+#include "NRA24TargetSelector.hpp"
+#include "RangeFilter.hpp"
+#include "SerialPort.hpp"
 
 #define NRA24_DEFAULT_PORT	"/dev/ttyS2"
 #define NRA24_MAX_DISTANCE	        50.0f
 #define NRA24_MIN_DISTANCE	        0.315f
+#define NRA24_MAX_INSTANCES	4
+
+/*
+ * drv_sensor.h has no device type for the NRA24. Reuse the one of the uLanding radar, which is never fitted
+ * together with it, instead of a private value that could clash with another device type.
+ */
+#ifndef DRV_DIST_DEVTYPE_NRA24
+#define DRV_DIST_DEVTYPE_NRA24	DRV_DIST_DEVTYPE_ULANDING
+#endif
 
 using namespace time_literals;
 
 class NRA24 : public px4::ScheduledWorkItem
 {
 public:
-	NRA24(const char *port, uint8_t rotation = distance_sensor_s::ROTATION_DOWNWARD_FACING);
+	NRA24(const char *port, uint8_t rotation = distance_sensor_s::ROTATION_DOWNWARD_FACING, bool obstacle_mode = false);
 	virtual ~NRA24();
 
 	int init();
 
 	void print_info();
 
+	const char *get_port() const { return _port; }
+
 private:
 
 	int collect();
 
+	/**
+	 * Publish the nearest target of a cycle as obstacle_distance, in the sectors covered by the field of view.
+	 * A target is held for NRA24_OBST_HOLD if the following cycles have none.
+	 * @param range nearest target, -1 if the cycle has no target [m]
+	 */
+	void publish_obstacle_distance(float range, hrt_abstime timestamp_sample);
+
 	void Run() override;
 
 	void start();
 	void stop();
 
-	PX4Rangefinder	_px4_rangefinder;
+	/**
+	 * Device id of the radar on a serial port, unique per port: /dev/ttyS2 is bus 2, ...
+	 */
+	static uint32_t get_device_id(const char *port);
 
-	NRA24_PARSE_STATE _parse_state {NRA24_PARSE_STATE::NRA24_DECODE_INT};
+	PX4Rangefinder	_px4_rangefinder;
+	uORB::PublicationMulti<obstacle_distance_s> _obstacle_distance_pub{ORB_ID(obstacle_distance)};
 
-	char _linebuf[29] {};
+	serial_frame::SerialFrameDecoder<NRA24Protocol> _decoder;
 	char _port[20] {};
 
+	static constexpr float NRA24_RANGE_NOISE{0.1f};			// standard deviation of the range [m]
 	static constexpr uint32_t NRA24_MEASURE_INTERVAL{10_ms};	// 25ms default sensor conversion time.
+	static constexpr uint32_t NRA24_BYTE_TIME{87};			// time to transmit 1 byte @ 115200 bps [us]
+	static constexpr uint32_t NRA24_FRAME_LENGTH{NRA24_FRAME_SIZE};	// length of a frame [bytes]
+	static constexpr uint32_t NRA24_FRAME_TIME{NRA24_BYTE_TIME * NRA24_FRAME_LENGTH};
+	static constexpr float NRA24_FOV{18.0f};			// horizontal field of view [deg]
+	static constexpr uint8_t NRA24_OBST_BINS{sizeof(obstacle_distance_s::distances) / sizeof(obstacle_distance_s::distances[0])};
+	static constexpr float NRA24_OBST_INCREMENT{360.0f / NRA24_OBST_BINS};	// sector width [deg]
+
+	NRA24TargetSelector _target_selector;
+	uint32_t _latency{0};			// sensor latency [us]
+
+	const uint8_t _rotation;
+	const bool _obstacle_mode;		// publish obstacle_distance instead of distance_sensor
+	bool _empty_cycle{false};		// the radar reported a cycle without targets
+	uint32_t _obstacle_hold{300_ms};
+	float _obstacle_range{-1.0f};		// last detected obstacle [m]
+	hrt_abstime _obstacle_timestamp{0};
 
 	int _fd{-1};
 
-	unsigned int _linebuf_index{0};
-
 	hrt_abstime _last_read{0};
-	float distance_track;
+	RangeFilter _filter;
+
+	// perf counter names include the port, they have to outlive the counters
+	char _comms_errors_name[40] {};
+	char _sample_perf_name[40] {};
+	char _dropped_cycles_name[40] {};
 
-	perf_counter_t _comms_errors{perf_alloc(PC_COUNT, MODULE_NAME": com_err")};
-	perf_counter_t _sample_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": read")};
+	perf_counter_t _comms_errors{nullptr};
+	perf_counter_t _sample_perf{nullptr};
+	perf_counter_t _dropped_cycles{nullptr};
 
 };
@@ -41,66 +41,98 @@
 namespace nra24
 {
 
-NRA24	*g_dev{nullptr};
+NRA24	*g_dev[NRA24_MAX_INSTANCES] {};
 
-int start(const char *port, uint8_t rotation);
+int start(const char *port, uint8_t rotation, bool obstacle_mode);
 int status();
-int stop();
+int stop(const char *port);
 int usage();
 
 int
-start(const char *port, uint8_t rotation)
+start(const char *port, uint8_t rotation, bool obstacle_mode)
 {
-	if (g_dev != nullptr) {
-		PX4_ERR("already started");
-		return PX4_OK;
+	int free_slot = -1;
+
+	for (int i = 0; i < NRA24_MAX_INSTANCES; i++) {
+		if (g_dev[i] == nullptr) {
+			if (free_slot < 0) {
+				free_slot = i;
+			}
+
+		} else if (!strcmp(g_dev[i]->get_port(), port)) {
+			PX4_ERR("already started on %s", port);
+			return PX4_OK;
+		}
+	}
+
+	if (free_slot < 0) {
+		PX4_ERR("max %d instances", NRA24_MAX_INSTANCES);
+		return PX4_ERROR;
 	}
 
 	// Instantiate the driver.
-	g_dev = new NRA24(port, rotation);
+	NRA24 *dev = new NRA24(port, rotation, obstacle_mode);
 
-	if (g_dev == nullptr) {
+	if (dev == nullptr) {
 		PX4_ERR("driver start failed");
 		return PX4_ERROR;
 	}
 
-	if (OK != g_dev->init()) {
+	if (OK != dev->init()) {
 		PX4_ERR("driver start failed");
-		delete g_dev;
-		g_dev = nullptr;
+		delete dev;
 		return PX4_ERROR;
 	}
 
+	g_dev[free_slot] = dev;
+
 	return PX4_OK;
 }
 
 int
 status()
 {
-	if (g_dev == nullptr) {
+	bool running = false;
+
+	for (int i = 0; i < NRA24_MAX_INSTANCES; i++) {
+		if (g_dev[i] != nullptr) {
+			printf("instance %d: state @ %p\n", i, g_dev[i]);
+			g_dev[i]->print_info();
+			running = true;
+		}
+	}
+
+	if (!running) {
 		PX4_ERR("driver not running");
 		return 1;
 	}
 
-	printf("state @ %p\n", g_dev);
-	g_dev->print_info();
-
 	return 0;
 }
 
-int stop()
+/**
+ * Stop the instance on a port, or all instances if port is nullptr
+ */
+int stop(const char *port)
 {
-	if (g_dev != nullptr) {
-		PX4_INFO("stopping driver");
-		delete g_dev;
-		g_dev = nullptr;
-		PX4_INFO("driver stopped");
+	bool stopped = false;
+
+	for (int i = 0; i < NRA24_MAX_INSTANCES; i++) {
+		if (g_dev[i] != nullptr && (port == nullptr || !strcmp(g_dev[i]->get_port(), port))) {
+			PX4_INFO("stopping driver on %s", g_dev[i]->get_port());
+			delete g_dev[i];
+			g_dev[i] = nullptr;
+			stopped = true;
+		}
+	}
 
-	} else {
+	if (!stopped) {
 		PX4_ERR("driver not running");
 		return 1;
 	}
 
+	PX4_INFO("driver stopped");
+
 	return PX4_OK;
 }
 
@@ -121,8 +153,16 @@ Setup/usage information: https://docs.px4.io/en/sensor/tfmini.html
 
 Attempt to start driver on a specified serial device.
 $ nra24 start -d /dev/ttyS1
-Stop driver
-$ nra24 stop
+
+Several radars can be used at the same time, one per serial device, e.g. for altitude and forward obstacle ranging.
+$ nra24 start -d /dev/ttyS1 -R 25
+$ nra24 start -d /dev/ttyS2 -R 0
+
+In obstacle mode, the targets are published as obstacle_distance for collision prevention, instead of distance_sensor.
+$ nra24 start -d /dev/ttyS2 -R 0 -o
+
+Stop the driver on one serial device, or all instances without -d
+$ nra24 stop -d /dev/ttyS2
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("nra24", "driver");
@@ -130,8 +170,10 @@ $ nra24 stop
 	PRINT_MODULE_USAGE_COMMAND_DESCR("start","Start driver");
 	PRINT_MODULE_USAGE_PARAM_STRING('d', nullptr, nullptr, "Serial device", false);
 	PRINT_MODULE_USAGE_PARAM_INT('R', 25, 1, 25, "Sensor rotation - downward facing by default", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('o', "Obstacle mode: publish obstacle_distance (needs a horizontal rotation)", true);
 	PRINT_MODULE_USAGE_COMMAND_DESCR("status","Driver status");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("stop","Stop driver");
+	PRINT_MODULE_USAGE_PARAM_STRING('d', nullptr, nullptr, "Serial device, all instances if not set", true);
 	PRINT_MODULE_USAGE_COMMAND_DESCR("test","Test driver (basic functional tests)");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("status","Print driver status");
 	return PX4_OK;
@@ -144,17 +186,24 @@ extern "C" __EXPORT int nra24_main(int argc, char *argv[])
 	int ch = 0;
 	uint8_t rotation = distance_sensor_s::ROTATION_DOWNWARD_FACING;
 	const char *device_path = NRA24_DEFAULT_PORT;
+	bool device_set = false;
+	bool obstacle_mode = false;
 	int myoptind = 1;
 	const char *myoptarg = nullptr;
 
-	while ((ch = px4_getopt(argc, argv, "R:d:", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "R:d:o", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 'R':
 			rotation = (uint8_t)atoi(myoptarg);
 			break;
 
+		case 'o':
+			obstacle_mode = true;
+			break;
+
 		case 'd':
 			device_path = myoptarg;
+			device_set = true;
 			break;
 
 		default:
@@ -170,7 +219,7 @@ extern "C" __EXPORT int nra24_main(int argc, char *argv[])
 
 	if (!strcmp(argv[myoptind], "start")) {
 		if (strcmp(device_path, "") != 0) {
-			return nra24::start(device_path, rotation);
+			return nra24::start(device_path, rotation, obstacle_mode);
 
 		} else {
 			PX4_WARN("Please specify device path!");
@@ -178,7 +227,7 @@ extern "C" __EXPORT int nra24_main(int argc, char *argv[])
 		}
 
 	} else if (!strcmp(argv[myoptind], "stop")) {
-		return nra24::stop();
+		return nra24::stop(device_set ? device_path : nullptr);
 
 	} else if (!strcmp(argv[myoptind], "status")) {
 		return nra24::status();
@@ -51,6 +51,10 @@ TFMINI::~TFMINI()
 	// make sure we are truly inactive
 	stop();
 
+	if (_fd >= 0) {
+		::close(_fd);
+	}
+
 	perf_free(_sample_perf);
 	perf_free(_comms_errors);
 }
@@ -58,95 +62,65 @@ TFMINI::~TFMINI()
 int
 TFMINI::init()
 {
-	int32_t hw_model = 1; // only one model so far...
+	int32_t hw_model = 1;
+	param_t handle = param_find("TFMINI_MODEL");
+
+	if (handle != PARAM_INVALID) {
+		param_get(handle, &hw_model);
+	}
 
 	switch (hw_model) {
 	case 1: // TFMINI (12m, 100 Hz)
 		_px4_rangefinder.set_min_distance(0.3f);
 		_px4_rangefinder.set_max_distance(12.0f);
 		_px4_rangefinder.set_fov(math::radians(1.15f));
+		_strength_min = 20;
 
 		break;
 
-	default:
-		PX4_ERR("invalid HW model %d.", hw_model);
-		return -1;
-	}
-
-	// status
-	int ret = 0;
-
-	do { // create a scope to handle exit conditions using break
-
-		// open fd
-		_fd = ::open(_port, O_RDWR | O_NOCTTY);
+	case 2: // TFMINI-S (12m, 100 Hz)
+		_px4_rangefinder.set_min_distance(0.1f);
+		_px4_rangefinder.set_max_distance(12.0f);
+		_px4_rangefinder.set_fov(math::radians(2.0f));
+		_strength_min = 100;
 
-		if (_fd < 0) {
-			PX4_ERR("Error opening fd");
-			return -1;
-		}
+		break;
 
-		// baudrate 115200, 8 bits, no parity, 1 stop bit
-		unsigned speed = B115200;
-		termios uart_config{};
-		int termios_state{};
+	case 3: // TF02 (22m, 100 Hz)
+		_px4_rangefinder.set_min_distance(0.4f);
+		_px4_rangefinder.set_max_distance(22.0f);
+		_px4_rangefinder.set_fov(math::radians(3.0f));
+		_strength_min = 20;
 
-		tcgetattr(_fd, &uart_config);
+		break;
 
-		// clear ONLCR flag (which appends a CR for every LF)
-		uart_config.c_oflag &= ~ONLCR;
+	default:
+		PX4_ERR("invalid HW model %d.", hw_model);
+		return -1;
+	}
 
-		// set baud rate
-		if ((termios_state = cfsetispeed(&uart_config, speed)) < 0) {
-			PX4_ERR("CFG: %d ISPD", termios_state);
-			ret = -1;
-			break;
-		}
+	float latency_ms = 0.0f;
+	handle = param_find("TFMINI_LATENCY");
 
-		if ((termios_state = cfsetospeed(&uart_config, speed)) < 0) {
-			PX4_ERR("CFG: %d OSPD\n", termios_state);
-			ret = -1;
-			break;
-		}
+	if (handle != PARAM_INVALID) {
+		param_get(handle, &latency_ms);
+	}
 
-		if ((termios_state = tcsetattr(_fd, TCSANOW, &uart_config)) < 0) {
-			PX4_ERR("baud %d ATTR", termios_state);
-			ret = -1;
-			break;
-		}
+	_latency = (uint32_t)(math::max(latency_ms, 0.0f) * 1000.0f);
+	_decoder.configure(TFMINI_BYTE_TIME, _latency);
 
-		uart_config.c_cflag |= (CLOCAL | CREAD);	// ignore modem controls
-		uart_config.c_cflag &= ~CSIZE;
-		uart_config.c_cflag |= CS8;			// 8-bit characters
-		uart_config.c_cflag &= ~PARENB;			// no parity bit
-		uart_config.c_cflag &= ~CSTOPB;			// only need 1 stop bit
-		uart_config.c_cflag &= ~CRTSCTS;		// no hardware flowcontrol
-
-		// setup for non-canonical mode
-		uart_config.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON);
-		uart_config.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
-		uart_config.c_oflag &= ~OPOST;
-
-		// fetch bytes as they become available
-		uart_config.c_cc[VMIN] = 1;
-		uart_config.c_cc[VTIME] = 1;
-
-		if (_fd < 0) {
-			PX4_ERR("FAIL: laser fd");
-			ret = -1;
-			break;
-		}
-	} while (0);
+	_filter.configure_from_params("TFMINI", TFMINI_RANGE_NOISE);
 
-	// close the fd
-	::close(_fd);
-	_fd = -1;
+	// baudrate 115200, 8 bits, no parity, 1 stop bit, non-blocking reads: the available bytes are polled
+	_fd = serial_port_open(_port, B115200);
 
-	if (ret == PX4_OK) {
-		start();
+	if (_fd < 0) {
+		return -1;
 	}
 
-	return ret;
+	start();
+
+	return PX4_OK;
 }
 
 int
@@ -157,69 +131,57 @@ TFMINI::collect()
 	// clear buffer if last read was too long ago
 	int64_t read_elapsed = hrt_elapsed_time(&_last_read);
 
-	// the buffer for read chars is buflen minus null termination
-	char readbuf[sizeof(_linebuf)] {};
-	unsigned readlen = sizeof(readbuf) - 1;
-
-	int ret = 0;
 	float distance_m = -1.0f;
+	int8_t quality = -1;
+	hrt_abstime timestamp_sample = 0;
+
+	// decode all complete frames, the bytes of an incomplete frame are kept for the next read
+	int ret = _decoder.collect(_fd, [&](const tfmini_frame_s & frame, hrt_abstime frame_timestamp) {
+		// invalid measurement: too weak or saturated signal, or out of range (negative distance)
+		if (frame.strength < _strength_min || frame.strength == 0xFFFF || frame.distance >= 0xFFFC) {
+			return;
+		}
 
-	// Check the number of bytes available in the buffer
-	int bytes_available = 0;
-	::ioctl(_fd, FIONREAD, (unsigned long)&bytes_available);
+		distance_m = frame.distance * 0.01f;
+		quality = (int8_t)(math::min((int)frame.strength, (int)TFMINI_STRENGTH_MAX) * 100 / TFMINI_STRENGTH_MAX);
+		timestamp_sample = frame_timestamp;
+	});
 
-	if (!bytes_available) {
+	if (ret < 0) {
+		PX4_ERR("read err: %d", ret);
+		perf_count(_comms_errors);
 		perf_end(_sample_perf);
-		return -EAGAIN;
-	}
-
-	// parse entire buffer
-	const hrt_abstime timestamp_sample = hrt_absolute_time();
 
-	do {
-		// read from the sensor (uart buffer)
-		ret = ::read(_fd, &readbuf[0], readlen);
+		// only throw an error if we time out
+		if (read_elapsed > (kCONVERSIONINTERVAL * 2)) {
+			/* flush anything in RX buffer */
+			tcflush(_fd, TCIFLUSH);
+			_decoder.reset();
+			return ret;
 
-		if (ret < 0) {
-			PX4_ERR("read err: %d", ret);
-			perf_count(_comms_errors);
-			perf_end(_sample_perf);
-
-			// only throw an error if we time out
-			if (read_elapsed > (kCONVERSIONINTERVAL * 2)) {
-				/* flush anything in RX buffer */
-				tcflush(_fd, TCIFLUSH);
-				return ret;
-
-			} else {
-				return -EAGAIN;
-			}
+		} else {
+			return -EAGAIN;
 		}
+	}
 
+	if (ret > 0) {
 		_last_read = hrt_absolute_time();
-
-		// parse buffer
-		for (int i = 0; i < ret; i++) {
-			tfmini_parse(readbuf[i], _linebuf, &_linebuf_index, &_parse_state, &distance_m);
-		}
-		// mavlink_log_info(&mavlink_log_pub, "tfmini current distance------- %.2f m\r\n", (double)distance_m);
-
-		// bytes left to parse
-		bytes_available -= ret;
-
-	} while (bytes_available > 0);
+	}
 
 	// no valid measurement after parsing buffer
 	if (distance_m < 0.0f) {
 		perf_end(_sample_perf);
 		return -EAGAIN;
 	}
-	float _distance_temp;
-	_distance_temp = distance_track + 0.65f * (distance_m - distance_track);
-	distance_track = _distance_temp;
+
+	// drop outliers
+	if (!_filter.update(distance_m, timestamp_sample)) {
+		perf_end(_sample_perf);
+		return PX4_OK;
+	}
 
 	// publish most recent valid measurement from buffer
-	_px4_rangefinder.update(timestamp_sample, distance_track);
+	_px4_rangefinder.update(timestamp_sample, _filter.filtered(), quality);
 
 	perf_end(_sample_perf);
 
@@ -242,12 +204,6 @@ TFMINI::stop()
 void
 TFMINI::Run()
 {
-	// fds initialized?
-	if (_fd < 0) {
-		// open fd
-		_fd = ::open(_port, O_RDWR | O_NOCTTY);
-	}
-
 	// perform collection
 	if (collect() == -EAGAIN) {
 		// reschedule to grab the missing bits, time to transmit 9 bytes @ 115200 bps
@@ -261,6 +217,8 @@ void
 TFMINI::print_info()
 {
 	printf("Using port '%s'\n", _port);
+	printf("range raw: %.2f m, filtered: %.2f m, rejected: %u\n", (double)_filter.raw(), (double)_filter.filtered(),
+	       _filter.rejected());
 	perf_print_counter(_sample_perf);
 	perf_print_counter(_comms_errors);
 
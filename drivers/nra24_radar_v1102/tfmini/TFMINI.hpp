@@ -48,6 +48,7 @@
 
 #include <drivers/drv_hrt.h>
 #include <lib/perf/perf_counter.h>
+#include <parameters/param.h>
 #include <px4_config.h>
 #include <px4_module.h>
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
@@ -55,6 +56,8 @@
 #include <uORB/topics/distance_sensor.h>
 
 #include "tfmini_parser.h"
+#include "RangeFilter.hpp"
+#include "SerialPort.hpp"
 
 #define TFMINI_DEFAULT_PORT	"/dev/ttyS3"
 
@@ -81,19 +84,20 @@ private:
 
 	PX4Rangefinder	_px4_rangefinder;
 
-	TFMINI_PARSE_STATE _parse_state {TFMINI_PARSE_STATE::NRA24_DECODE_INT};
-
-	char _linebuf[10] {};
+	serial_frame::SerialFrameDecoder<TFminiProtocol> _decoder;
 	char _port[20] {};
 
+	static constexpr float TFMINI_RANGE_NOISE{0.05f};	// standard deviation of the range [m]
 	static constexpr int kCONVERSIONINTERVAL{9_ms};
+	static constexpr uint32_t TFMINI_BYTE_TIME{87};		// time to transmit 1 byte @ 115200 bps [us]
+	static constexpr uint16_t TFMINI_STRENGTH_MAX{1000};	// strength mapped to 100 signal quality
 
 	int _fd{-1};
 
-	unsigned int _linebuf_index{0};
-
 	hrt_abstime _last_read{0};
-	float distance_track;
+	RangeFilter _filter;
+	uint32_t _latency{0};	// sensor latency [us]
+	uint16_t _strength_min{20};	// below this strength the measurement is unreliable
 
 	perf_counter_t _comms_errors{perf_alloc(PC_COUNT, MODULE_NAME": com_err")};
 	perf_counter_t _sample_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": read")};
@@ -0,0 +1,138 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * TFmini latency
+ *
+ * Time between the measurement and the start of the transmission of its frame.
+ * It is subtracted from the sample timestamp, in addition to the transmission time.
+ *
+ * @unit ms
+ * @min 0
+ * @max 100
+ * @decimal 1
+ * @reboot_required true
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(TFMINI_LATENCY, 0.0f);
+
+/**
+ * TFmini range filter type
+ *
+ * Filter applied to the range before it is published.
+ * The alpha-beta filter and the Kalman filter estimate the rate of change of the range, which gives less
+ * lag than the moving average. The Kalman filter additionally rejects outliers (see TFMINI_FLT_GATE).
+ *
+ * @reboot_required true
+ * @min 0
+ * @max 4
+ * @group Sensors
+ * @value 0 Off
+ * @value 1 Exponential moving average
+ * @value 2 Alpha-beta filter
+ * @value 3 Kalman filter with outlier rejection
+ * @value 4 Median of 5 samples
+ */
+PARAM_DEFINE_INT32(TFMINI_FLT_TYPE, 1);
+
+/**
+ * TFmini range filter alpha
+ *
+ * Gain of the moving average and position gain of the alpha-beta filter.
+ * 1 means no filtering.
+ *
+ * @min 0
+ * @max 1
+ * @decimal 2
+ * @reboot_required true
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(TFMINI_FLT_ALPHA, 0.65f);
+
+/**
+ * TFmini range filter beta
+ *
+ * Velocity gain of the alpha-beta filter.
+ *
+ * @min 0
+ * @max 1
+ * @decimal 2
+ * @reboot_required true
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(TFMINI_FLT_BETA, 0.1f);
+
+/**
+ * TFmini range filter process noise
+ *
+ * Expected rate of change of the range velocity, used by the Kalman filter.
+ * Higher values give less lag, lower values more smoothing.
+ *
+ * @unit m/s^2
+ * @min 0.1
+ * @max 20
+ * @decimal 1
+ * @reboot_required true
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(TFMINI_FLT_ACC, 2.0f);
+
+/**
+ * TFmini range filter outlier gate
+ *
+ * Measurements with an innovation larger than this number of standard deviations are rejected
+ * by the Kalman filter. Set to 0 to disable.
+ *
+ * @unit SD
+ * @min 0
+ * @max 10
+ * @decimal 1
+ * @reboot_required true
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(TFMINI_FLT_GATE, 3.0f);
+
+/**
+ * TFmini model
+ *
+ * Sets the range limits and the minimum signal strength of the sensor.
+ *
+ * @reboot_required true
+ * @min 1
+ * @max 3
+ * @group Sensors
+ * @value 1 TFmini
+ * @value 2 TFmini-S
+ * @value 3 TF02
+ */
+PARAM_DEFINE_INT32(TFMINI_MODEL, 1);
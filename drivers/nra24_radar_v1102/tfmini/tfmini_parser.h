@@ -52,27 +52,35 @@
 // 4) Dist_H (high 8bit)
 // 5) Strength_L (low 8bit)
 // 6) Strength_H (high 8bit)
-// 7) Reserved bytes
-// 8) Original signal quality degree
+// 7) Reserved bytes (TFmini-S: Temp_L, TF02: reliability)
+// 8) Original signal quality degree (TFmini-S: Temp_H, TF02: exposure time)
 // 9) Checksum parity bit (low 8bit), Checksum = Byte1 + Byte2 +...+Byte8. This is only a low 8bit though
+//
+// The distance is in cm (standard output format). The TFmini-S reports invalid measurements as
+// negative distances (0xFFFF, 0xFFFE, 0xFFFC), all models report an unreliable strength as 0xFFFF.
 
+#include <stdint.h>
 
-enum class TFMINI_PARSE_STATE {
-	NRA24_DECODE_INT = 0,
-	NRA24_DECODE_ENDSEQ1,
-	NRA24_DECODE_ENDSEQ2,
-	// NRA24_DECODE_STARTSEQ1,
-	// NRA24_DECODE_STARTSEQ2,
-	NRA24_DECODE_MESG_ID_L,
-	NRA24_DECODE_MESG_ID_H,
-	NRA24_DECODE_INDEX,
-	NRA24_DECODE_RCS,
-	NRA24_DECODE_RANGE_H,
-	NRA24_DECODE_RANGE_L,
-	NRA24_DECODE_RSVD1,
-	NRA24_DECODE_ROLLCOUNT_A,
-	NRA24_DECODE_ROLLCOUNT_B,
-	NRA24_DECODE_CHECKSUM
+#include "SerialFrameDecoder.hpp"
+
+#define TFMINI_FRAME_SIZE	9
+
+/** Decoded frame */
+struct tfmini_frame_s {
+	uint16_t distance;	///< [cm]
+	uint16_t strength;
 };
 
-int tfmini_parse(char c, char *parserbuf, unsigned *parserbuf_index, TFMINI_PARSE_STATE *state, float *dist);
+/**
+ * Frame layout: 0x59 0x59 header, checksum over all other bytes, no trailer
+ */
+struct TFminiProtocol : public serial_frame::FrameLayout<0x59, 0x59, TFMINI_FRAME_SIZE, serial_frame::Checksum::Sum8, 0, 8> {
+	using Frame = tfmini_frame_s;
+
+	static bool decode(const uint8_t *buf, Frame &frame)
+	{
+		frame.distance = buf[2] | buf[3] << 8;
+		frame.strength = buf[4] | buf[5] << 8;
+		return true;
+	}
+};
@@ -42,8 +42,10 @@
  */
 
 #include <px4_config.h>
-#include <px4_workqueue.h>
 #include <px4_getopt.h>
+#include <px4_tasks.h>
+#include <px4_sem.h>
+#include <px4_time.h>
 
 #include <sys/types.h>
 #include <stdint.h>
@@ -58,9 +60,11 @@
 #include <math.h>
 #include <unistd.h>
 #include <termios.h>
+#include <sys/ioctl.h>
 
 #include <perf/perf_counter.h>
 #include <systemlib/err.h>
+#include <parameters/param.h>
 
 #include <drivers/drv_hrt.h>
 #include <drivers/drv_range_finder.h>
@@ -73,14 +77,17 @@
 #include <board_config.h>
 
 #include "nra24_parser.h"
+#include "NRA24TargetSelector.hpp"
+#include "RangeFilter.hpp"
+#include "SerialPort.hpp"
 #include <systemlib/mavlink_log.h>
 
 extern orb_advert_t mavlink_log_pub;
 /* Configuration Constants */
-
-#ifndef CONFIG_SCHED_WORKQUEUE
-# error This requires CONFIG_SCHED_WORKQUEUE.
-#endif
+#define NRA24_BYTE_TIME			87	/* time to transmit 1 byte @ 115200 bps [us] */
+#define NRA24_POLL_TIMEOUT		100	/* [ms] */
+#define NRA24_QUEUE_DEPTH_MAX		100
+#define NRA24_RANGE_NOISE		0.1f	/* standard deviation of the range [m] */
 
 class NRA24 : public device::CDev
 {
@@ -104,18 +111,15 @@ private:
 	float                    _min_distance;
 	float                    _max_distance;
 	int                      _conversion_interval;
-	work_s                   _work;
 	ringbuffer::RingBuffer  *_reports;
-	int                      _measure_ticks;
-	bool                     _collect_phase;
+	unsigned                 _measure_interval;	/* publication interval [us], 0 in manual mode */
+	hrt_abstime              _last_publish;
 	int                      _fd;
-	char                     _linebuf[15];
-	unsigned                 _linebuf_index;
-	enum NRA24_PARSE_STATE  _parse_state;
+	serial_frame::SerialFrameDecoder<NRA24Protocol> _decoder;
+	NRA24TargetSelector      _target_selector;
 
 	hrt_abstime              _last_read;
-	float		distance_track;
-
+	RangeFilter              _filter;
 
 	int                      _class_instance;
 	int                      _orb_class_instance;
@@ -124,40 +128,47 @@ private:
 
 	unsigned                 _consecutive_fail_count;
 
+	int                      _task_id;
+	volatile bool            _task_should_exit;
+	volatile bool            _task_running;
+
+	px4_sem_t                _report_sem;		/* posted by the driver task after queueing a report for a waiting manual read */
+	volatile bool            _report_wanted;
+
 	perf_counter_t           _sample_perf;
 	perf_counter_t           _comms_errors;
+	perf_counter_t           _queue_overflows;
 
 	/**
-	* Initialise the automatic measurement state machine and start it.
-	*
-	* @note This function is called at open and error time.  It might make sense
-	*       to make it more aggressive about resetting the bus in case of errors.
+	* Start the driver task, which collects the measurements as they arrive.
 	*/
 	void				start();
 
 	/**
-	* Stop the automatic measurement state machine.
+	* Stop the driver task and wait for it to exit.
 	*/
 	void				stop();
 
 	/**
-	* Perform a poll cycle; collect from the previous measurement
-	* and start a new one.
+	* Driver task: wait for data on the serial port and collect it, instead
+	* of polling on the shared work queue.
 	*/
-	void				cycle();
+	void				task_main();
 	int				collect();
 
 	/**
-	* Static trampoline from the workq context; because we don't have a
-	* generic workq wrapper yet.
-	*
-	* @param arg		Instance pointer for the driver that is polling.
+	* Static trampoline to the driver task.
 	*/
-	static void			cycle_trampoline(void *arg);
+	static int			task_main_trampoline(int argc, char *argv[]);
 
 
 };
 
+namespace nra24
+{
+extern NRA24	*g_dev;
+}
+
 /*
  * Driver 'main' command.
  */
@@ -170,19 +181,21 @@ NRA24::NRA24(const char *port, uint8_t rotation) :
 	_max_distance(50.0f),
 	_conversion_interval(10000),
 	_reports(nullptr),
-	_measure_ticks(0),
-	_collect_phase(false),
+	_measure_interval(0),
+	_last_publish(0),
 	_fd(-1),
-	_linebuf_index(0),
-	_parse_state(NRA24_DECODE_INT),
 	_last_read(0),
-	distance_track(0.0f),
 	_class_instance(-1),
 	_orb_class_instance(-1),
 	_distance_sensor_topic(nullptr),
 	_consecutive_fail_count(0),
+	_task_id(-1),
+	_task_should_exit(false),
+	_task_running(false),
+	_report_wanted(false),
 	_sample_perf(perf_alloc(PC_ELAPSED, "nra24_read")),
-	_comms_errors(perf_alloc(PC_COUNT, "nra24_com_err"))
+	_comms_errors(perf_alloc(PC_COUNT, "nra24_com_err")),
+	_queue_overflows(perf_alloc(PC_COUNT, "nra24_queue_overflow"))
 {
 	/* store port name */
 	strncpy(_port, port, sizeof(_port));
@@ -192,8 +205,9 @@ NRA24::NRA24(const char *port, uint8_t rotation) :
 	// disable debug() calls
 	_debug_enabled = false;
 
-	// work_cancel in the dtor will explode if we don't do this...
-	memset(&_work, 0, sizeof(_work));
+	/* the semaphore is used for signaling, not for locking */
+	px4_sem_init(&_report_sem, 0, 0);
+	px4_sem_setprotocol(&_report_sem, SEM_PRIO_NONE);
 }
 
 NRA24::~NRA24()
@@ -201,6 +215,10 @@ NRA24::~NRA24()
 	/* make sure we are truly inactive */
 	stop();
 
+	if (_fd >= 0) {
+		::close(_fd);
+	}
+
 	/* free any existing reports */
 	if (_reports != nullptr) {
 		delete _reports;
@@ -212,6 +230,9 @@ NRA24::~NRA24()
 
 	perf_free(_sample_perf);
 	perf_free(_comms_errors);
+	perf_free(_queue_overflows);
+
+	px4_sem_destroy(&_report_sem);
 }
 
 int
@@ -223,65 +244,25 @@ NRA24::init()
 		_max_distance = 50.0f;
 		_conversion_interval =	10000;
 
-	/* status */
-	int ret = 0;
-
-	do { /* create a scope to handle exit conditions using break */
-
-		/* open fd */
-		_fd = ::open(_port, O_RDWR | O_NOCTTY | O_SYNC);
-
-		if (_fd < 0) {
-			warnx("Error opening fd");
-			return -1;
-		}
-
-		/*baudrate 115200, 8 bits, no parity, 1 stop bit */
-		unsigned speed = B115200;
-
-		struct termios uart_config;
-
-		int termios_state;
+	int32_t target_mode = 0;
+	param_t handle = param_find("NRA24_TGT_MODE");
 
-		tcgetattr(_fd, &uart_config);
+	if (handle != PARAM_INVALID) {
+		param_get(handle, &target_mode);
+	}
 
-		/* clear ONLCR flag (which appends a CR for every LF) */
-		uart_config.c_oflag &= ~ONLCR;
+	_target_selector.configure((NRA24TargetSelector::Mode)target_mode, _min_distance);
 
-		/* set baud rate */
-		if ((termios_state = cfsetispeed(&uart_config, speed)) < 0) {
-			warnx("ERR CFG: %d ISPD", termios_state);
-			ret = -1;
-			break;
-		}
+	_decoder.configure(NRA24_BYTE_TIME, 0);
+	_filter.configure_from_params("NRA24", NRA24_RANGE_NOISE);
 
-		if ((termios_state = cfsetospeed(&uart_config, speed)) < 0) {
-			warnx("ERR CFG: %d OSPD\n", termios_state);
-			ret = -1;
-			break;
-		}
-
-		if ((termios_state = tcsetattr(_fd, TCSANOW, &uart_config)) < 0) {
-			warnx("ERR baud %d ATTR", termios_state);
-			ret = -1;
-			break;
-		}
-
-		uart_config.c_cflag |= (CLOCAL | CREAD);    /* ignore modem controls */
-		uart_config.c_cflag &= ~CSIZE;
-		uart_config.c_cflag |= CS8;         /* 8-bit characters */
-		uart_config.c_cflag &= ~PARENB;     /* no parity bit */
-		uart_config.c_cflag &= ~CSTOPB;     /* only need 1 stop bit */
-		uart_config.c_cflag &= ~CRTSCTS;    /* no hardware flowcontrol */
+	/* status */
+	int ret = 0;
 
-		/* setup for non-canonical mode */
-		uart_config.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON);
-		uart_config.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
-		uart_config.c_oflag &= ~OPOST;
+	do { /* create a scope to handle exit conditions using break */
 
-		/* fetch bytes as they become available */
-		uart_config.c_cc[VMIN] = 1;
-		uart_config.c_cc[VTIME] = 1;
+		/* open fd, it is kept for the lifetime of the driver */
+		_fd = serial_port_open(_port, B115200);
 
 		if (_fd < 0) {
 			warnx("FAIL: radar fd");
@@ -294,8 +275,15 @@ NRA24::init()
 
 		if (ret != OK) { break; }
 
-		/* allocate basic report buffers */
-		_reports = new ringbuffer::RingBuffer(2, sizeof(distance_sensor_s));
+		/* allocate the report queue, deep enough for consumers reading in batches */
+		int32_t queue_depth = 10;
+		param_get(param_find("NRA24_QUEUE_LEN"), &queue_depth);
+
+		if (queue_depth < 1 || queue_depth > NRA24_QUEUE_DEPTH_MAX) {
+			queue_depth = 10;
+		}
+
+		_reports = new ringbuffer::RingBuffer(queue_depth, sizeof(distance_sensor_s));
 
 		if (_reports == nullptr) {
 			warnx("mem err");
@@ -317,10 +305,6 @@ NRA24::init()
 
 	} while (0);
 
-	/* close the fd */
-	::close(_fd);
-	_fd = -1;
-
 	return ret;
 }
 
@@ -332,10 +316,10 @@ NRA24::ioctl(device::file_t *filp, int cmd, unsigned long arg)
 	case SENSORIOCSPOLLRATE: {
 			switch (arg) {
 
-			/* switching to manual polling */
+			/* switching to manual polling: reports are only queued, not published */
 			case SENSOR_POLLRATE_MANUAL:
-				stop();
-				_measure_ticks = 0;
+				_measure_interval = 0;
+				start();
 				return OK;
 
 			/* external signalling (DRDY) not supported */
@@ -348,41 +332,29 @@ NRA24::ioctl(device::file_t *filp, int cmd, unsigned long arg)
 			/* set default/max polling rate */
 			case SENSOR_POLLRATE_MAX:
 			case SENSOR_POLLRATE_DEFAULT: {
-					/* do we need to start internal polling? */
-					bool want_start = (_measure_ticks == 0);
+					/* publish every measurement */
+					_measure_interval = _conversion_interval;
 
-					/* set interval for next measurement to minimum legal value */
-					_measure_ticks = USEC2TICK(_conversion_interval);
-
-					/* if we need to start the poll state machine, do it */
-					if (want_start) {
-						start();
-					}
+					/* the task is started on the first request */
+					start();
 
 					return OK;
 				}
 
 			/* adjust to a legal polling interval in Hz */
 			default: {
-
-					/* do we need to start internal polling? */
-					bool want_start = (_measure_ticks == 0);
-
-					/* convert hz to tick interval via microseconds */
-					unsigned ticks = USEC2TICK(1000000 / arg);
+					/* convert hz to microseconds */
+					unsigned interval = 1000000 / arg;
 
 					/* check against maximum rate */
-					if (ticks < USEC2TICK(_conversion_interval)) {
+					if (interval < (unsigned)_conversion_interval) {
 						return -EINVAL;
 					}
 
-					/* update interval for next measurement */
-					_measure_ticks = ticks;
+					/* update interval for next publication */
+					_measure_interval = interval;
 
-					/* if we need to start the poll state machine, do it */
-					if (want_start) {
-						start();
-					}
+					start();
 
 					return OK;
 				}
@@ -390,15 +362,15 @@ NRA24::ioctl(device::file_t *filp, int cmd, unsigned long arg)
 		}
 
 	case SENSORIOCGPOLLRATE:
-		if (_measure_ticks == 0) {
+		if (_measure_interval == 0) {
 			return SENSOR_POLLRATE_MANUAL;
 		}
 
-		return (1000 / _measure_ticks);
+		return (1000000 / _measure_interval);
 
 	case SENSORIOCSQUEUEDEPTH: {
 			/* lower bound is mandatory, upper bound is a sanity check */
-			if ((arg < 1) || (arg > 100)) {
+			if ((arg < 1) || (arg > NRA24_QUEUE_DEPTH_MAX)) {
 				return -EINVAL;
 			}
 
@@ -437,43 +409,53 @@ NRA24::read(device::file_t *filp, char *buffer, size_t buflen)
 	}
 
 	/* if automatic measurement is enabled */
-	if (_measure_ticks > 0) {
+	if (_measure_interval > 0) {
 
 		/*
 		 * While there is space in the caller's buffer, and reports, copy them.
-		 * Note that we may be pre-empted by the workq thread while we are doing this;
-		 * we are careful to avoid racing with them.
+		 * The queue is lock-free (single producer: the driver task, single consumer),
+		 * so this does not block the driver task.
 		 */
-		while (count--) {
-			if (_reports->get(rbuf)) {
-				ret += sizeof(*rbuf);
-				rbuf++;
-			}
+		while (count > 0 && _reports->get(rbuf)) {
+			ret += sizeof(*rbuf);
+			rbuf++;
+			count--;
 		}
 
 		/* if there was no data, warn the caller */
 		return ret ? ret : -EAGAIN;
 	}
 
-	/* manual measurement - run one conversion */
-	do {
-		_reports->flush();
+	/* manual measurement - block until the driver task queues the next one */
+	_report_wanted = true;
+	_reports->flush();
 
-		/* wait for it to complete */
-		usleep(_conversion_interval);
+	struct timespec abstime = {};
+	px4_clock_gettime(CLOCK_REALTIME, &abstime);
+	const uint64_t timeout_nsec = abstime.tv_nsec + 2ULL * _conversion_interval * 1000;
+	abstime.tv_sec += timeout_nsec / 1000000000;
+	abstime.tv_nsec = timeout_nsec % 1000000000;
 
-		/* run the collection phase */
-		if (OK != collect()) {
-			ret = -EIO;
-			break;
-		}
+	ret = -EIO;
 
-		/* state machine will have generated a report, copy it out */
+	for (;;) {
 		if (_reports->get(rbuf)) {
 			ret = sizeof(*rbuf);
+			break;
 		}
 
-	} while (0);
+		/* posts of an earlier read are consumed here, the queue is checked again after each of them */
+		if (px4_sem_timedwait(&_report_sem, &abstime) != 0 && errno != EINTR) {
+			/* timed out */
+			if (_reports->get(rbuf)) {
+				ret = sizeof(*rbuf);
+			}
+
+			break;
+		}
+	}
+
+	_report_wanted = false;
 
 	return ret;
 }
@@ -488,13 +470,20 @@ NRA24::collect()
 	/* clear buffer if last read was too long ago */
 	uint64_t read_elapsed = hrt_elapsed_time(&_last_read);
 
-	/* the buffer for read chars is buflen minus null termination */
-	char readbuf[sizeof(_linebuf)];
-	unsigned readlen = sizeof(readbuf) - 1;
+	float distance_m = -1.0f;
+
+	/*
+	 * decode all complete frames, the bytes of an incomplete frame are kept for the next read.
+	 * The target info frames of a cycle are grouped, and one target is selected per cycle.
+	 */
+	ret = _decoder.collect(_fd, [this, &distance_m](const nra24_frame_s & frame, hrt_abstime timestamp_sample) {
+		const float distance = _target_selector.handle_frame(frame, timestamp_sample);
+
+		if (distance >= 0.0f) {
+			distance_m = distance;
+		}
+	});
 
-	/* read from the sensor (uart buffer) */
-	ret = ::read(_fd, &readbuf[0], readlen);
-	
 	if (ret < 0) {
 		DEVICE_DEBUG("read err: %d", ret);
 		perf_count(_comms_errors);
@@ -509,56 +498,58 @@ NRA24::collect()
 		}
 
 	} else if (ret == 0) {
+		perf_end(_sample_perf);
 		return -EAGAIN;
 	}
-    // float frequency = 1000000.0f / (hrt_absolute_time() - _last_read);
 
 	_last_read = hrt_absolute_time();
 
-	float distance_m = -1.0f;
-	int roll_count = -1;
-
-	for (int i = 0; i < ret; i++) {
-		nra24_parser(readbuf[i], _linebuf, &_linebuf_index, &_parse_state, &distance_m, &roll_count);
-	}
-
-	if (distance_m <= 0.0f) {
+	/* no complete cycle with a valid target */
+	if (distance_m < 0.0f) {
 		perf_end(_sample_perf);
 		return -EAGAIN;
 	}
-	// mavlink_log_info(&mavlink_log_pub, "nra24 current distance------- %.2f m, ---freq %.2f\r\n", (double)distance_m, (double)frequency);
-	float _distance_temp;
-	if (fabsf(distance_track - distance_m) >= 1.5f){
-	_distance_temp = distance_track + 0.5f * (distance_m - distance_track);
 
-	} else {
-	_distance_temp = distance_track + 0.85f * (distance_m - distance_track);
+	const hrt_abstime timestamp_sample = _target_selector.timestamp();
 
-	}
-	distance_track = _distance_temp;
+	DEVICE_DEBUG("val (float): %8.4f", (double)distance_m);
 
-	DEVICE_DEBUG("val (float): %8.4f, raw: %s, valid: %s", (double)distance_m, _linebuf);
+	/* outlier rejected by the filter, don't publish it */
+	if (!_filter.update(distance_m, timestamp_sample)) {
+		perf_end(_sample_perf);
+		return -EAGAIN;
+	}
 
 	struct distance_sensor_s report;
 
-	report.timestamp = hrt_absolute_time();
+	report.timestamp = timestamp_sample;
 	report.type = distance_sensor_s::MAV_DISTANCE_SENSOR_RADAR;
 	report.orientation = _rotation;
-	report.current_distance = distance_m;
+	report.current_distance = _filter.filtered();
 	report.min_distance = _min_distance;
 	report.max_distance = _max_distance;
 	report.covariance = 0.0f;
 	/* TODO: set proper ID */
 	report.id = 0;
 
-	/* publish it */
-	orb_publish(ORB_ID(distance_sensor), _distance_sensor_topic, &report);
+	/* publish it, at the requested rate */
+	if (_measure_interval > 0 && hrt_elapsed_time(&_last_publish) + _conversion_interval / 2 >= _measure_interval) {
+		orb_publish(ORB_ID(distance_sensor), _distance_sensor_topic, &report);
+		_last_publish = report.timestamp;
+	}
 
-	_reports->force(&report);
+	/* queue every report, overwrite the oldest one if no one reads them */
+	if (_reports->force(&report)) {
+		perf_count(_queue_overflows);
+	}
 
 	/* notify anyone waiting for data */
 	poll_notify(POLLIN);
 
+	if (_report_wanted) {
+		px4_sem_post(&_report_sem);
+	}
+
 	ret = OK;
 
 	perf_end(_sample_perf);
@@ -568,99 +559,106 @@ NRA24::collect()
 void
 NRA24::start()
 {
+	if (_task_running) {
+		return;
+	}
+
 	/* reset the report ring and state machine */
-	_collect_phase = false;
 	_reports->flush();
+	_decoder.reset();
+	_target_selector.reset();
+	_filter.reset();
+
+	_task_should_exit = false;
+	_task_running = true;
+
+	_task_id = px4_task_spawn_cmd("nra24", SCHED_DEFAULT,
+				      SCHED_PRIORITY_SLOW_DRIVER, 1200,
+				      (px4_main_t)&NRA24::task_main_trampoline, nullptr);
 
-	/* schedule a cycle to start things */
-	work_queue(HPWORK, &_work, (worker_t)&NRA24::cycle_trampoline, this, 1);
+	if (_task_id < 0) {
+		DEVICE_LOG("task start failed");
+		_task_running = false;
+	}
 }
 
 void
 NRA24::stop()
 {
-	work_cancel(HPWORK, &_work);
+	if (!_task_running) {
+		return;
+	}
+
+	_task_should_exit = true;
+
+	/* the task wakes up at least every NRA24_POLL_TIMEOUT */
+	for (unsigned i = 0; i < 50 && _task_running; i++) {
+		usleep(10000);
+	}
+
+	if (_task_running) {
+		px4_task_delete(_task_id);
+		_task_running = false;
+	}
+
+	_task_id = -1;
 }
 
-void
-NRA24::cycle_trampoline(void *arg)
+int
+NRA24::task_main_trampoline(int argc, char *argv[])
 {
-	NRA24 *dev = (NRA24 *)arg;
-
-	dev->cycle();
+	nra24::g_dev->task_main();
+	return 0;
 }
 
 void
-NRA24::cycle()
+NRA24::task_main()
 {
-	/* fds initialized? */
-	if (_fd < 0) {
-		/* open fd */
-		_fd = ::open(_port, O_RDWR | O_NOCTTY | O_SYNC);
-	}
+	pollfd fds[1];
+	fds[0].fd = _fd;
+	fds[0].events = POLLIN;
+
+	while (!_task_should_exit) {
+		/* wake up when data arrives, instead of guessing when the next frame is due */
+		int ret = ::poll(fds, 1, NRA24_POLL_TIMEOUT);
+
+		if (ret < 0) {
+			perf_count(_comms_errors);
+			usleep(10000);
+			continue;
+		}
 
-	/* collection phase? */
-	if (_collect_phase) {
+		if (ret == 0 || !(fds[0].revents & POLLIN)) {
+			continue;
+		}
 
-		/* perform collection */
-		int collect_ret = collect();
+		/* don't read a frame byte by byte, wait for the rest of it to arrive */
+		int bytes_available = 0;
 
-		if (collect_ret == -EAGAIN) {
-			/* reschedule to grab the missing bits, time to transmit 8 bytes @ 9600 bps */
-			work_queue(HPWORK,
-				   &_work,
-				   (worker_t)&NRA24::cycle_trampoline,
-				   this,
-				   USEC2TICK(1042 * 8));
-			return;
+		if (::ioctl(_fd, FIONREAD, (unsigned long)&bytes_available) != 0) {
+			bytes_available = 0;
 		}
 
-		if (OK != collect_ret) {
+		if (bytes_available < NRA24_FRAME_SIZE) {
+			usleep((NRA24_FRAME_SIZE - bytes_available) * NRA24_BYTE_TIME);
+		}
+
+		int collect_ret = collect();
 
+		if (collect_ret == OK) {
+			_consecutive_fail_count = 0;
+
+		} else if (collect_ret != -EAGAIN) {
 			/* we know the sensor needs about four seconds to initialize */
 			if (hrt_absolute_time() > 5 * 1000 * 1000LL && _consecutive_fail_count < 5) {
 				DEVICE_LOG("collection error #%u", _consecutive_fail_count);
 			}
 
 			_consecutive_fail_count++;
-
-			/* restart the measurement state machine */
-			start();
-			return;
-
-		} else {
-			/* apparently success */
-			_consecutive_fail_count = 0;
-		}
-
-		/* next phase is measurement */
-		_collect_phase = false;
-
-		/*
-		 * Is there a collect->measure gap?
-		 */
-		if (_measure_ticks > USEC2TICK(_conversion_interval)) {
-
-			/* schedule a fresh cycle call when we are ready to measure again */
-			work_queue(HPWORK,
-				   &_work,
-				   (worker_t)&NRA24::cycle_trampoline,
-				   this,
-				   _measure_ticks - USEC2TICK(_conversion_interval));
-
-			return;
 		}
 	}
 
-	/* next phase is collection */
-	_collect_phase = true;
-
-	/* schedule a fresh cycle call when the measurement is done */
-	work_queue(HPWORK,
-		   &_work,
-		   (worker_t)&NRA24::cycle_trampoline,
-		   this,
-		   USEC2TICK(_conversion_interval));
+	_task_running = false;
 }
 
 void
@@ -669,7 +667,11 @@ NRA24::print_info()
 	printf("Using port '%s'\n", _port);
 	perf_print_counter(_sample_perf);
 	perf_print_counter(_comms_errors);
-	printf("poll interval:  %d ticks\n", _measure_ticks);
+	perf_print_counter(_queue_overflows);
+	printf("publish interval:  %u us\n", _measure_interval);
+	printf("target mode: %d, last roll count: %d\n", (int)_target_selector.mode(), _target_selector.roll_count());
+	printf("range raw: %.2f m, filtered: %.2f m, rejected: %u\n", (double)_filter.raw(), (double)_filter.filtered(),
+	       _filter.rejected());
 	_reports->print_info("report queue");
 }
 
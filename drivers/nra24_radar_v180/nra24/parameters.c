@@ -55,3 +55,107 @@ PARAM_DEFINE_INT32(NRA24_EN, 0);
  * @value 2 /dev/ttys6
  */
 PARAM_DEFINE_INT32(NRA24_DEV, 0);
+
+/**
+ * NRA24 radar report queue length
+ *
+ * Number of measurements buffered for readers of the device, which can read them in batches.
+ * When the queue is full, the oldest measurement is dropped.
+ *
+ * @reboot_required true
+ * @min 1
+ * @max 100
+ * @group Sensors
+ */
+PARAM_DEFINE_INT32(NRA24_QUEUE_LEN, 10);
+
+/**
+ * NRA24 radar target selection
+ *
+ * The radar reports up to 8 targets per measurement cycle. This selects the one used as distance.
+ *
+ * @reboot_required true
+ * @min 0
+ * @max 2
+ * @group Sensors
+ * @value 0 Nearest target
+ * @value 1 Strongest target (highest RCS)
+ * @value 2 Target closest to the previously selected one
+ */
+PARAM_DEFINE_INT32(NRA24_TGT_MODE, 0);
+
+/**
+ * NRA24 radar range filter type
+ *
+ * Filter applied to the range before it is published.
+ * The alpha-beta filter and the Kalman filter estimate the rate of change of the range, which gives less
+ * lag than the moving average. The Kalman filter additionally rejects outliers (see NRA24_FLT_GATE).
+ *
+ * @reboot_required true
+ * @min 0
+ * @max 4
+ * @group Sensors
+ * @value 0 Off
+ * @value 1 Exponential moving average
+ * @value 2 Alpha-beta filter
+ * @value 3 Kalman filter with outlier rejection
+ * @value 4 Median of 5 samples
+ */
+PARAM_DEFINE_INT32(NRA24_FLT_TYPE, 1);
+
+/**
+ * NRA24 radar range filter alpha
+ *
+ * Gain of the moving average and position gain of the alpha-beta filter.
+ * 1 means no filtering.
+ *
+ * @min 0
+ * @max 1
+ * @decimal 2
+ * @reboot_required true
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(NRA24_FLT_ALPHA, 0.65f);
+
+/**
+ * NRA24 radar range filter beta
+ *
+ * Velocity gain of the alpha-beta filter.
+ *
+ * @min 0
+ * @max 1
+ * @decimal 2
+ * @reboot_required true
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(NRA24_FLT_BETA, 0.1f);
+
+/**
+ * NRA24 radar range filter process noise
+ *
+ * Expected rate of change of the range velocity, used by the Kalman filter.
+ * Higher values give less lag, lower values more smoothing.
+ *
+ * @unit m/s^2
+ * @min 0.1
+ * @max 20
+ * @decimal 1
+ * @reboot_required true
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(NRA24_FLT_ACC, 2.0f);
+
+/**
+ * NRA24 radar range filter outlier gate
+ *
+ * Measurements with an innovation larger than this number of standard deviations are rejected
+ * by the Kalman filter. Set to 0 to disable.
+ *
+ * @unit SD
+ * @min 0
+ * @max 10
+ * @decimal 1
+ * @reboot_required true
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(NRA24_FLT_GATE, 3.0f);